@@ -22,335 +22,1933 @@
  */
 
 #include "APAPHX_ADS1015.h"
+#include <math.h>
+#include <string.h>
 
 /**
  * @brief Constructor initializes ADC with specified I2C address
  * @param i2cAddress The I2C address (0x48-0x4B) based on ADDR pin connection
+ * @param wire I2C bus the ADC is attached to (Wire, Wire1, ...)
  */
-ADS1015::ADS1015(uint8_t i2cAddress) {
+ADS1015::ADS1015(uint8_t i2cAddress, TwoWire& wire) {
     _i2cAddress = i2cAddress;
+    _wire = &wire;
+    setTemperatureTable(nullptr);
 }
 
 /**
  * @brief Initializes I2C communication for the ADC
+ * @param clockHz I2C clock in Hz, or 0 to keep the core default
  * Must be called before any operations with the sensor
+ * 
+ * The ADS1015 supports up to 400 kHz in fast mode and 3.4 MHz in
+ * high-speed mode; whether faster clocks work depends on the board
+ * and bus wiring.
+ */
+void ADS1015::begin(uint32_t clockHz) {
+    _wire->begin();
+    if (clockHz > 0) {
+        _wire->setClock(clockHz);
+    }
+    _pointer = 0xFF;  // Register pointer state unknown after (re)initialization
+}
+
+/**
+ * @brief Moves the ADC to another I2C bus and initializes it
+ * @param wire I2C bus the ADC is attached to
+ * @param clockHz I2C clock in Hz, or 0 to keep the core default
+ */
+void ADS1015::begin(TwoWire& wire, uint32_t clockHz) {
+    _wire = &wire;
+    begin(clockHz);
+}
+
+/**
+ * @brief Sets ADC gain/voltage range
+ * @param gain Use predefined gain settings (e.g., ADS1015_REG_SET_GAIN1_4_096V)
+ * Higher gain provides better resolution but smaller voltage range
+ */
+void ADS1015::setGain(uint16_t gain) {
+    _gain = gain;
+    _mVPerCode = millivoltsPerCode(gain);  // Precomputed so samples never need it
+}
+
+/**
+ * @brief Enables or disables automatic gain selection
+ * @param enabled True to pick the gain from the measured signal
+ */
+void ADS1015::enableAutoRange(bool enabled) {
+    _autoRange = enabled;
+    _autoRangeKnown = false;  // Measure afresh with the next reading
+}
+
+/**
+ * @brief Position of a gain setting from widest (0 = 6.144V) to tightest (5 = 0.256V)
+ * @param gain ADS1015_REG_SET_GAINx setting
+ * @return Range index; unknown settings count as the widest range
+ */
+uint8_t ADS1015::gainIndex(uint16_t gain) {
+    uint8_t index = gain >> 9;  // PGA bits are 000..101 for 6.144V..0.256V
+    return (index > 5) ? 5 : index;
+}
+
+/**
+ * @brief Gain setting of a range index
+ * @param index 0 (6.144V) to 5 (0.256V)
+ * @return ADS1015_REG_SET_GAINx setting
+ */
+uint16_t ADS1015::gainSetting(uint8_t index) {
+    return (uint16_t)((index > 5) ? 5 : index) << 9;
+}
+
+/**
+ * @brief Tightest range a signal peak fits in
+ * @param peak_mV Largest absolute sample in mV
+ * @param percent Share of full scale the peak may use
+ * @return Range index 0 (6.144V) to 5 (0.256V)
+ */
+uint8_t ADS1015::fittingGainIndex(float peak_mV, uint8_t percent) {
+    for (uint8_t index = 5; index > 0; index--) {
+        float fullScale_mV = millivoltsPerCode(gainSetting(index)) * 2048.0f;
+        if (peak_mV < fullScale_mV * percent / 100.0f) {
+            return index;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Checks a collected sample against the auto-range limits
+ * @param code Raw 12-bit ADC code at the reading's current gain
+ * @return True when the gain changed and the reading restarted (sample discarded)
+ * 
+ * The probe sample picks the range directly; a sample above
+ * AUTO_RANGE_WIDEN_PERCENT of full scale may be clipped, so the reading
+ * starts over one range wider. Samples of one reading therefore always
+ * share a gain, and statistics, filters and stored samples need no
+ * per-sample rescaling.
+ */
+bool ADS1015::autoRangeSample(int16_t code) {
+    uint8_t current = gainIndex(_gain);
+    uint8_t target = current;
+    
+    if (_autoRangeProbe) {
+        _autoRangeProbe = false;
+        target = fittingGainIndex(abs(code) * _mVPerCode, AUTO_RANGE_TIGHTEN_PERCENT);
+    } else if (abs(code) >= 2047L * AUTO_RANGE_WIDEN_PERCENT / 100 && current > 0) {
+        target = current - 1;
+    }
+    if (target == current) return false;
+    
+    setGain(gainSetting(target));
+    ScanChannel& ch = _channels[0];
+    ch.config.gain = _gain;
+    ch.mVPerCode = _mVPerCode;
+    prepareTransform(ch);  // Breakpoints are in codes of the new gain
+    resetAccumulator(ch.acc);
+    _currentSample = 0;
+    _scanIndex = 0;
+    setupFilter(_config.filter, _config.filter_hz);
+    
+    if (_continuousRunning) {
+        startContinuous(_config.input);  // Reconfigure; first result after a full conversion
+    } else {
+        _conversionPending = false;      // Next conversion starts at the new gain
+    }
+    return true;
+}
+
+/**
+ * @brief Picks the gain for the next reading from the peak of this one
+ * 
+ * Only tightens: widening happens during the reading when a sample
+ * approaches full scale. Between the two thresholds the gain is kept.
+ */
+void ADS1015::autoRangeAfterReading() {
+    const Accumulator& acc = _channels[0].acc;
+    _autoRangeKnown = true;
+    _autoRangeInput = _config.input;
+    if (acc.validSamples == 0) return;
+    
+    int16_t peak = (abs(acc.min) > abs(acc.max)) ? abs(acc.min) : abs(acc.max);
+    uint8_t target = fittingGainIndex(peak * _mVPerCode, AUTO_RANGE_TIGHTEN_PERCENT);
+    if (target > gainIndex(_gain)) {
+        setGain(gainSetting(target));
+    }
+}
+
+/**
+ * @brief Code-to-millivolt scale of a gain setting
+ * @param gain ADS1015_REG_SET_GAINx setting
+ * @return Millivolts per ADC code (full scale / 2048)
+ */
+float ADS1015::millivoltsPerCode(uint16_t gain) {
+    float voltageRange;
+    switch(gain) {
+        case ADS1015_REG_SET_GAIN0_6_144V: voltageRange = 6.144f; break;
+        case ADS1015_REG_SET_GAIN1_4_096V: voltageRange = 4.096f; break;
+        case ADS1015_REG_SET_GAIN2_2_048V: voltageRange = 2.048f; break;
+        case ADS1015_REG_SET_GAIN4_1_024V: voltageRange = 1.024f; break;
+        case ADS1015_REG_SET_GAIN8_0_512V: voltageRange = 0.512f; break;
+        case ADS1015_REG_SET_GAIN16_0_256V: voltageRange = 0.256f; break;
+        default: voltageRange = 6.144f;
+    }
+    return voltageRange * 1000.0f / 2048.0f;
+}
+
+/**
+ * @brief Sets ADC data rate
+ * @param rate Use predefined data rates (e.g., ADS1015_REG_CONFIG_DR_128SPS)
+ * 
+ * Also derives the conversion time used to schedule samples. The internal
+ * oscillator is specified to +/-10%, so the nominal period is padded accordingly.
+ */
+void ADS1015::setDataRate(uint16_t rate) {
+    static const uint16_t SPS[] = {128, 250, 490, 920, 1600, 2400, 3300, 3300};
+    
+    _dataRate = rate & 0x00E0;
+    unsigned long period = 1000000UL / SPS[_dataRate >> 5];
+    _conversionTimeUs = period + period / 10 + 10;
+}
+
+/**
+ * @brief Reads voltage from specified ADC channel
+ * @param channel ADC input channel (0-3)
+ * @return Raw 12-bit ADC value (0-2047)
+ * 
+ * Blocking convenience wrapper around the split conversion API: starts a
+ * single-shot conversion and waits only for the conversion time itself
+ */
+int16_t ADS1015::readADC_SingleEnded(uint8_t channel) {
+    if (channel > 3) return 0;
+
+    return readADC((PHXInput)channel);
+}
+
+/**
+ * @brief Reads a single-ended or differential input
+ * @param input Input selection (single-ended AINx or differential pair)
+ * @return Raw 12-bit ADC value (-2048 to 2047)
+ * 
+ * Blocking like readADC_SingleEnded()
+ */
+int16_t ADS1015::readADC(PHXInput input) {
+    startADC(input);
+    while (!conversionComplete()) {
+        // Between 0.3 ms (3300 SPS) and 8.6 ms (128 SPS)
+    }
+    return getLastConversionResult();
+}
+
+/**
+ * @brief Starts a single-shot conversion on specified ADC channel
+ * @param channel ADC input channel (0-3)
+ * 
+ * Writes the configuration register and returns immediately. Poll
+ * conversionComplete() and then call getLastConversionResult().
+ */
+void ADS1015::startADC_SingleEnded(uint8_t channel) {
+    if (channel > 3) return;
+
+    startADC((PHXInput)channel);
+}
+
+/**
+ * @brief Starts a single-shot conversion on a single-ended or differential input
+ * @param input Input selection (single-ended AINx or differential pair)
+ */
+void ADS1015::startADC(PHXInput input) {
+    startConversion(inputMux(input), _gain);
+}
+
+/**
+ * @brief Starts a single-shot conversion with an explicit gain
+ * @param mux ADS1015_REG_CONFIG_MUX_x input selection
+ * @param gain ADS1015_REG_SET_GAINx setting for this conversion
+ */
+void ADS1015::startConversion(uint16_t mux, uint16_t gain) {
+    uint16_t config = buildConfig(mux, gain, ADS1015_REG_CONFIG_MODE_SINGLE);  // Power down after conversion
+    config |= ADS1015_REG_CONFIG_OS_SINGLE;      // Start conversion
+
+    _conversionReady = false;
+    writeRegister(_i2cAddress, ADS1015_REG_POINTER_CONFIG, config);
+    _continuousRunning = false;
+    _conversionStart = micros();
+    _conversionPending = true;
+}
+
+/**
+ * @brief Puts the ADC into continuous conversion on specified channel
+ * @param channel ADC input channel (0-3)
+ */
+void ADS1015::startContinuous(uint8_t channel) {
+    if (channel > 3) return;
+
+    startContinuous((PHXInput)channel);
+}
+
+/**
+ * @brief Puts the ADC into continuous conversion on a single-ended or differential input
+ * @param input Input selection (single-ended AINx or differential pair)
+ * 
+ * The config register is only written when the running configuration
+ * differs; afterwards every getLastConversionResult() is a plain 2-byte
+ * read because the register pointer stays on the conversion register.
+ */
+void ADS1015::startContinuous(PHXInput input) {
+    if (alarmOwnsADC()) return;
+    
+    uint16_t config = buildConfig(inputMux(input), _gain, ADS1015_REG_CONFIG_MODE_CONTIN);
+    if (!_continuousRunning || config != _continuousConfig) {
+        // Only a written config counts as running; otherwise the ADC may
+        // still be powered down and samples fall back to single-shot
+        _continuousRunning = writeRegister(_i2cAddress, ADS1015_REG_POINTER_CONFIG, config);
+        _continuousConfig = config;
+    }
+    
+    // First result is only valid after a full conversion with this config
+    _conversionReady = false;
+    _conversionStart = micros();
+    _conversionPending = true;
+}
+
+/**
+ * @brief Stops continuous conversion and lets the ADC power down
+ */
+void ADS1015::stopContinuous() {
+    if (!_continuousRunning || alarmOwnsADC()) return;
+
+    writeRegister(_i2cAddress, ADS1015_REG_POINTER_CONFIG,
+                  _continuousConfig | ADS1015_REG_CONFIG_MODE_SINGLE);
+    _continuousRunning = false;
+    _conversionPending = false;
+}
+
+/**
+ * @brief Checks whether the alarm comparator is using the ADC
+ * @return True while an alarm is enabled and no reading is running
+ */
+bool ADS1015::alarmOwnsADC() const {
+    return _alarmEnabled && _state == PHXState::IDLE;
+}
+
+/**
+ * @brief Enables continuous streaming for readings
+ * @param enabled True to stream, false for single-shot conversions
+ * 
+ * Disabling while idle powers the ADC down immediately; otherwise the
+ * running reading finishes streaming and the next reading stops it.
+ */
+void ADS1015::enableContinuousMode(bool enabled) {
+    _continuousMode = enabled;
+    if (!enabled && _state == PHXState::IDLE) {
+        stopContinuous();
+    }
+}
+
+/**
+ * @brief Check if continuous streaming is enabled
+ * @return True if enabled, false if disabled
+ */
+bool ADS1015::isContinuousModeEnabled() const {
+    return _continuousMode;
+}
+
+/**
+ * @brief Enables ALERT/RDY conversion-ready signalling
+ * @param enabled True to wait for the ALERT/RDY pin, false for time-based polling
+ * 
+ * Per the datasheet, Hi_thresh MSB = 1 and Lo_thresh MSB = 0 with the
+ * comparator queue enabled turn ALERT/RDY into a conversion-ready output.
+ * Disabling restores the power-on thresholds and disables the comparator.
+ * Enabling replaces a threshold alarm.
+ */
+void ADS1015::enableConversionReady(bool enabled) {
+    if (!enabled && !_conversionReadyMode) return;  // Nothing to undo; an alarm may own the thresholds
+    
+    if (enabled) {
+        disableAlarm();  // ALERT/RDY serves one purpose at a time
+
+        writeRegister(_i2cAddress, ADS1015_REG_POINTER_HITHRESH, 0x8000);
+        writeRegister(_i2cAddress, ADS1015_REG_POINTER_LOWTHRESH, 0x0000);
+        _comparatorQueue = ADS1015_REG_CONFIG_CQUE_1CONV;
+    } else {
+        writeRegister(_i2cAddress, ADS1015_REG_POINTER_HITHRESH, 0x7FFF);
+        writeRegister(_i2cAddress, ADS1015_REG_POINTER_LOWTHRESH, 0x8000);
+        _comparatorQueue = ADS1015_REG_CONFIG_CQUE_NONE;
+    }
+    _conversionReadyMode = enabled;
+    _continuousRunning = false;  // Force a config write with the new queue bits
+}
+
+/**
+ * @brief Check if ALERT/RDY conversion-ready signalling is enabled
+ * @return True if enabled, false if disabled
+ */
+bool ADS1015::isConversionReadyEnabled() const {
+    return _conversionReadyMode;
+}
+
+/**
+ * @brief Starts watching an input with the window comparator
+ * @param alarm Limits, input, fault count and latching
+ * @return False while a reading is running or conversion-ready signalling is
+ *         enabled, or if a limit lies outside the widest input range
+ */
+bool ADS1015::enableAlarm(const PHXAlarmConfig& alarm) {
+    if (_state != PHXState::IDLE || _conversionReadyMode) return false;
+    
+    _alarm = alarm;
+    _alarmEnabled = true;
+    _alarmTriggered = false;
+    _alertPending = false;
+    return restoreAlarm();
+}
+
+/**
+ * @brief Stops the comparator, restores the power-on thresholds and powers down
+ */
+void ADS1015::disableAlarm() {
+    if (!_alarmEnabled) return;
+    
+    _alarmEnabled = false;
+    writeRegister(_i2cAddress, ADS1015_REG_POINTER_HITHRESH, 0x7FFF);
+    writeRegister(_i2cAddress, ADS1015_REG_POINTER_LOWTHRESH, 0x8000);
+    
+    // A plain single-shot config without OS disables the comparator and
+    // lets the ADC power down
+    if (_state == PHXState::IDLE) {
+        writeRegister(_i2cAddress, ADS1015_REG_POINTER_CONFIG,
+                      buildConfig(inputMux(_alarm.input), _gain, ADS1015_REG_CONFIG_MODE_SINGLE));
+        _continuousRunning = false;
+        _conversionPending = false;
+    }
+}
+
+/**
+ * @brief Acknowledges an alarm
+ * 
+ * Reading the conversion register releases a latched ALERT/RDY pin. While
+ * a reading is running the comparator is paused and the pin already released.
+ */
+void ADS1015::clearAlarm() {
+    _alarmTriggered = false;
+    _alertPending = false;
+    if (_alarmEnabled && _alarm.latching && _state == PHXState::IDLE) {
+        readRegister(_i2cAddress, ADS1015_REG_POINTER_CONVERT);
+    }
+}
+
+/**
+ * @brief Programs the thresholds and starts the comparator
+ * 
+ * Called when the alarm is enabled and after every reading, whose config
+ * writes pause the comparator. Thresholds are recomputed each time so they
+ * follow calibration and temperature changes.
+ * 
+ * The comparator converts at its own gain, the tightest range that holds
+ * both limits below ALARM_RANGE_PERCENT of full scale. A limit at full
+ * scale could never be exceeded (conversions saturate there), and the
+ * reading gain, which auto-ranging may tighten after any reading, must
+ * not decide whether the alarm can fire.
+ * 
+ * @return False, with the alarm disabled, if a limit lies outside the
+ *         widest range
+ */
+bool ADS1015::restoreAlarm() {
+    const CalCurve* curve = curveForType(_alarm.type);
+    
+    // A falling calibration slope swaps which limit is the lower voltage
+    float low_mV = alarmLimitMilliVolts(_alarm.low, curve);
+    float high_mV = alarmLimitMilliVolts(_alarm.high, curve);
+    if (low_mV > high_mV) {
+        float swap = low_mV;
+        low_mV = high_mV;
+        high_mV = swap;
+    }
+    
+    float peak_mV = (fabsf(low_mV) > fabsf(high_mV)) ? fabsf(low_mV) : fabsf(high_mV);
+    float widest_mV = millivoltsPerCode(ADS1015_REG_SET_GAIN0_6_144V) * 2048.0f;
+    if (!(peak_mV < widest_mV * ALARM_RANGE_PERCENT / 100.0f)) {
+        disableAlarm();
+        return false;
+    }
+    uint16_t gain = gainSetting(fittingGainIndex(peak_mV, ALARM_RANGE_PERCENT));
+    float mVPerCode = millivoltsPerCode(gain);
+    int16_t lowCode = (int16_t)floorf(low_mV / mVPerCode + 0.5f);
+    int16_t highCode = (int16_t)floorf(high_mV / mVPerCode + 0.5f);
+    
+    // Thresholds are compared against the left-justified conversion register
+    writeRegister(_i2cAddress, ADS1015_REG_POINTER_LOWTHRESH, (uint16_t)lowCode << 4);
+    writeRegister(_i2cAddress, ADS1015_REG_POINTER_HITHRESH, (uint16_t)highCode << 4);
+    
+    uint16_t queue = ADS1015_REG_CONFIG_CQUE_1CONV;
+    if (_alarm.faults >= 4) {
+        queue = ADS1015_REG_CONFIG_CQUE_4CONV;
+    } else if (_alarm.faults >= 2) {
+        queue = ADS1015_REG_CONFIG_CQUE_2CONV;
+    }
+    
+    uint16_t config = gain |
+                      ADS1015_REG_CONFIG_MODE_CONTIN |
+                      _dataRate |
+                      ADS1015_REG_CONFIG_CMODE_WINDOW |
+                      (_alarm.latching ? ADS1015_REG_CONFIG_CLAT_LATCH : 0) |
+                      queue |
+                      inputMux(_alarm.input);
+    writeRegister(_i2cAddress, ADS1015_REG_POINTER_CONFIG, config);
+    
+    // Readings reconfigure the ADC before using it
+    _continuousConfig = config;
+    _continuousRunning = true;
+    _conversionPending = false;
+    return true;
+}
+
+/**
+ * @brief Converts an alarm limit to the input voltage it corresponds to
+ * @param limit Limit in pH, ORP mV or raw mV
+ * @param curve Calibration of the limit's type, nullptr for raw mV
+ * @return Input in millivolts
+ * 
+ * Inverse of convertReading(): undoes temperature compensation for pH,
+ * then maps the value back through the calibration segment whose mV
+ * range contains the solution.
+ */
+float ADS1015::alarmLimitMilliVolts(float limit, const CalCurve* curve) const {
+    float mV = limit;
+    if (curve != nullptr && curve->count > 0) {
+        float scale, offset;
+        temperatureTransform(_alarm.type, scale, offset);
+        float value = (limit - offset) / scale;
+        
+        bool invertible = false;
+        for (uint8_t i = 0; i < curve->count; i++) {
+            const CalSegment& segment = curve->segments[i];
+            if (fabsf(segment.slope) <= 1e-6f) continue;  // Flat segment has no inverse
+            
+            float candidate = (value - segment.offset) / segment.slope;
+            bool inside = (i == 0 || candidate >= segment.from_mV) &&
+                          (i + 1 == curve->count || candidate < curve->segments[i + 1].from_mV);
+            if (inside || !invertible) {
+                mV = candidate;  // Falls back to the first invertible segment
+                invertible = true;
+            }
+            if (inside) break;
+        }
+    }
+    
+    return mV;
+}
+
+/**
+ * @brief Checks if the pending conversion has finished
+ * @return True when no conversion is pending or the conversion is done
+ * 
+ * Time-based by default, so polling costs no bus traffic. With
+ * conversion-ready signalling the ALERT/RDY notification decides; a
+ * conversion that was never signalled is accepted after
+ * READY_TIMEOUT_FACTOR conversion times so a missed edge cannot stall
+ * a reading.
+ */
+bool ADS1015::conversionComplete() const {
+    if (!_conversionPending) return true;
+    
+    unsigned long elapsed = micros() - _conversionStart;
+    if (_conversionReadyMode) {
+        return _conversionReady ||
+               elapsed >= _conversionTimeUs * READY_TIMEOUT_FACTOR;
+    }
+    return elapsed >= _conversionTimeUs;
+}
+
+/**
+ * @brief Reads the conversion register
+ * @return Raw 12-bit ADC value of the last finished conversion (-2048 to 2047)
+ * 
+ * In continuous mode the next conversion is already running, so the
+ * pending flag is re-armed to keep following reads at least one
+ * conversion apart. A direct single-shot conversion paused an enabled
+ * alarm (its config write replaced the comparator's), so the alarm is
+ * re-armed once the result is fetched.
+ */
+int16_t ADS1015::getLastConversionResult() {
+    _conversionReady = false;
+    if (_continuousRunning) {
+        _conversionStart = micros();
+    } else {
+        _conversionPending = false;
+    }
+    
+    // Read and return 12-bit result; the signed shift keeps negative
+    // (differential or below-ground) results negative
+    int16_t result = (int16_t)readRegister(_i2cAddress, ADS1015_REG_POINTER_CONVERT) >> 4;
+    if (_alarmEnabled && _state == PHXState::IDLE && !_continuousRunning) {
+        restoreAlarm();
+    }
+    return result;
+}
+
+/**
+ * @brief Assembles the configuration register value
+ * @param mux ADS1015_REG_CONFIG_MUX_x input selection
+ * @param gain ADS1015_REG_SET_GAINx setting
+ * @param mode ADS1015_REG_CONFIG_MODE_SINGLE or ADS1015_REG_CONFIG_MODE_CONTIN
+ * @return Config register value without the OS bit
+ */
+uint16_t ADS1015::buildConfig(uint16_t mux, uint16_t gain, uint16_t mode) const {
+    return gain |                               // Voltage range
+           mode |                               // Single-shot or continuous
+           _dataRate |                          // Samples per second
+           _comparatorQueue |                   // ALERT/RDY usage
+           mux;                                 // Input selection
+}
+
+/**
+ * @brief Maps an input selection to its config register mux bits
+ * @param input Single-ended AINx or differential pair
+ * @return ADS1015_REG_CONFIG_MUX_x value
+ */
+uint16_t ADS1015::inputMux(PHXInput input) {
+    switch (input) {
+        case PHXInput::DIFF_0_1: return ADS1015_REG_CONFIG_MUX_DIFF_0_1;
+        case PHXInput::DIFF_0_3: return ADS1015_REG_CONFIG_MUX_DIFF_0_3;
+        case PHXInput::DIFF_1_3: return ADS1015_REG_CONFIG_MUX_DIFF_1_3;
+        case PHXInput::DIFF_2_3: return ADS1015_REG_CONFIG_MUX_DIFF_2_3;
+        default:
+            return ADS1015_REG_CONFIG_MUX_SINGLE_0 + (((uint8_t)input & 0x03) * 0x1000);
+    }
+}
+
+/**
+ * @brief Performs two-register I2C write
+ * @param i2cAddress Device address
+ * @param reg Register address
+ * @param value 16-bit value to write
+ * @return False if the transfer failed
+ * 
+ * Handles I2C protocol for writing 16-bit configuration values
+ */
+bool ADS1015::writeRegister(uint8_t i2cAddress, uint8_t reg, uint16_t value) {
+    _wire->beginTransmission(i2cAddress);
+    _wire->write((uint8_t)reg);
+    _wire->write((uint8_t)(value >> 8));    // High byte
+    _wire->write((uint8_t)(value & 0xFF));  // Low byte
+    if (_wire->endTransmission() != 0) {
+        _pointer = 0xFF;  // Unknown whether the pointer byte arrived
+        return false;
+    }
+    
+    _pointer = reg;
+    _busStats.transactions++;
+    _busStats.bytes += 4;  // Address + pointer + 2 data bytes
+    return true;
+}
+
+/**
+ * @brief Reads 16-bit value from ADC register
+ * @param i2cAddress Device address
+ * @param reg Register to read
+ * @return 16-bit register value, 0 if the transfer failed
+ * 
+ * Handles I2C protocol for reading conversion results. The register
+ * pointer is cached so repeated reads of the same register are a single
+ * 2-byte read transaction. A failed transfer forgets the cached pointer,
+ * so the next read sends it again instead of reading whichever register
+ * the device was left on.
+ */
+uint16_t ADS1015::readRegister(uint8_t i2cAddress, uint8_t reg) {
+    // Skip the pointer write when the device already points at reg
+    if (_pointer != reg) {
+        _wire->beginTransmission(i2cAddress);
+        _wire->write(reg);
+        if (_wire->endTransmission() != 0) {
+            _pointer = 0xFF;
+            return 0;
+        }
+        _pointer = reg;
+        _busStats.transactions++;
+        _busStats.bytes += 2;  // Address + pointer
+    }
+    
+    if (_wire->requestFrom(i2cAddress, (uint8_t)2) != 2) {
+        _pointer = 0xFF;
+        return 0;
+    }
+    _busStats.transactions++;
+    _busStats.bytes += 3;  // Address + 2 data bytes
+    
+    uint16_t value = _wire->read() << 8;  // High byte
+    return value | _wire->read();         // Combine with low byte
+}
+
+/**
+ * @brief Gets stable reading for calibration
+ * @param type Measurement type ("ph" or "rx")
+ * @param input Input the probe is connected to (must match PHXConfig::input of later readings)
+ * @return Stable voltage reading in mV
+ * 
+ * Blocking wrapper around startCalibration() with the default timeout.
+ * After a timeout the best value so far is returned and getLastError()
+ * reports PHXError::CAL_TIMEOUT.
+ * 
+ * NOTE: Temperature compensation is NOT applied during calibration.
+ * This is correct behavior - calibration should capture raw sensor response.
+ */
+float ADS1015::calibratePHXReading(const char* type, PHXInput input) {
+    startCalibration(type, input);
+    while(getState() != PHXState::IDLE) {
+        updateReading();
+    }
+    return _calibrationValue;
+}
+
+/**
+ * @brief Starts a non-blocking calibration reading
+ * @param type Measurement type ("ph" or "rx")
+ * @param input Input the probe is connected to (must match PHXConfig::input of later readings)
+ * @param timeout_ms Give up after this long, 0 to wait until stable
+ * 
+ * The state machine takes a reading, pauses (SETTLING), takes another and
+ * compares the two (STABILITY_CHECK) until consecutive readings agree
+ * within STABILITY_THRESHOLD. The timeout is checked between readings.
+ * Each reading ends as soon as its mean is known to half the threshold
+ * without drift, so a settled probe calibrates in a fraction of the time.
+ */
+void ADS1015::startCalibration(const char* type, PHXInput input, unsigned long timeout_ms) {
+    if (_state != PHXState::IDLE) return;
+    
+    _calConfig.type = type;
+    _calConfig.samples = 100;    // Use 100 samples for accuracy
+    _calConfig.delay_ms = 10;    // 10ms between samples
+    _calConfig.avg_buffer = 1;   // Calibration readings bypass the rolling average
+    _calConfig.input = input;
+    _calConfig.tolerance_mV = STABILITY_THRESHOLD / 2.0f;  // Readings end once settled
+    _calConfig.aggregation = PHXAggregation::MEAN;
+    _calConfig.filter = PHXFilter::NONE;
+    _calConfig.filter_hz = 0;
+    _calConfig.target_bits = 0;
+    
+    _calibrating = true;
+    _calStart = millis();
+    _calTimeout = timeout_ms;
+    _calReadings = 0;
+    _calPrevious = 0;
+    _calDrift = 0;
+    _calibrationValue = 0;
+    
+    // Raw millivolts: no calibration, so no temperature compensation either
+    beginSingleReading(_calConfig, nullptr);
+}
+
+/**
+ * @brief Gets progress of the running (or last) calibration
+ * @return Readings taken, current reading progress, drift and elapsed time
+ */
+PHXCalibrationProgress ADS1015::getCalibrationProgress() const {
+    PHXCalibrationProgress progress;
+    progress.percent = 100;
+    if (_state == PHXState::COLLECTING && _calibrating && _calConfig.samples > 0) {
+        progress.percent = (uint8_t)((long)_currentSample * 100 / _calConfig.samples);
+    }
+    progress.readings = _calReadings;
+    progress.drift_mV = _calDrift;
+    progress.elapsed_ms = millis() - _calStart;
+    return progress;
+}
+
+/**
+ * @brief Ends calibration and returns to IDLE
+ * @param error NONE when stable, CAL_TIMEOUT when given up
+ */
+void ADS1015::finishCalibration(PHXError error) {
+    _calibrating = false;
+    _lastError = error;
+    _state = PHXState::IDLE;
+    
+    if (_alarmEnabled) {
+        restoreAlarm();
+    }
+}
+
+/**
+ * @brief Stores calibration data for pH or ORP
+ * @param type Measurement type ("ph" or "rx")
+ * @param cal Calibration points and values
+ * 
+ * Stores two-point calibration data for converting voltage to pH or ORP.
+ * The line through the two points is derived here, once, so readings
+ * only multiply and add.
+ */
+void ADS1015::calibratePHX(const char* type, PHX_Calibration &cal) {
+    PHXCalibrationPoint points[2] = {
+        {cal.ref1_mV, cal.ref1_value},
+        {cal.ref2_mV, cal.ref2_value}
+    };
+    calibratePHXPoints(type, points, 2);
+}
+
+/**
+ * @brief Stores a calibration with two or more standards
+ * @param type Measurement type ("ph" or "rx")
+ * @param points Calibration points in any order
+ * @param count Number of points (2 to MAX_CAL_POINTS)
+ * @param fit Piecewise-linear or least-squares line
+ * @return True if the calibration was stored
+ */
+bool ADS1015::calibratePHXPoints(const char* type, const PHXCalibrationPoint* points, uint8_t count,
+                                 PHXCalibrationFit fit) {
+    CalCurve* curve = nullptr;
+    if (strcmp(type, "ph") == 0) {
+        curve = &_phCurve;
+    } else if (strcmp(type, "rx") == 0) {
+        curve = &_orpCurve;
+    } else {
+        return false;
+    }
+    return buildCurve(points, count, fit, *curve);
+}
+
+/**
+ * @brief Precomputes the segments of a calibration
+ * @param points Calibration points in any order
+ * @param count Number of points
+ * @param fit Piecewise-linear or least-squares line
+ * @param curve Receives the segments; count 0 (raw mV) when invalid
+ * @return False if the points cannot form a calibration
+ */
+bool ADS1015::buildCurve(const PHXCalibrationPoint* points, uint8_t count,
+                         PHXCalibrationFit fit, CalCurve& curve) {
+    curve.count = 0;
+    if (points == nullptr || count < 2 || count > MAX_CAL_POINTS) return false;
+    
+    // Sort a copy by mV (insertion sort, at most MAX_CAL_POINTS points)
+    PHXCalibrationPoint sorted[MAX_CAL_POINTS];
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t j = i;
+        while (j > 0 && sorted[j - 1].mV > points[i].mV) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = points[i];
+    }
+    
+    // Use raw mV if two standards read the same voltage
+    for (uint8_t i = 1; i < count; i++) {
+        if (sorted[i].mV - sorted[i - 1].mV <= 0.001f) return false;
+    }
+    
+    if (fit == PHXCalibrationFit::LEAST_SQUARES) {
+        // Regression of value on mV, centred for float precision
+        float meanMV = 0;
+        float meanValue = 0;
+        for (uint8_t i = 0; i < count; i++) {
+            meanMV += sorted[i].mV;
+            meanValue += sorted[i].value;
+        }
+        meanMV /= count;
+        meanValue /= count;
+        
+        float sxy = 0;
+        float sxx = 0;
+        for (uint8_t i = 0; i < count; i++) {
+            float dx = sorted[i].mV - meanMV;
+            sxy += dx * (sorted[i].value - meanValue);
+            sxx += dx * dx;
+        }
+        CalSegment& segment = curve.segments[0];
+        segment.from_mV = sorted[0].mV;
+        segment.slope = sxy / sxx;
+        segment.offset = meanValue - segment.slope * meanMV;
+        curve.count = 1;
+        return true;
+    }
+    
+    // Piecewise: one line per pair of neighbouring points
+    for (uint8_t i = 0; i + 1 < count; i++) {
+        CalSegment& segment = curve.segments[i];
+        segment.from_mV = sorted[i].mV;
+        segment.slope = (sorted[i + 1].value - sorted[i].value) / (sorted[i + 1].mV - sorted[i].mV);
+        segment.offset = sorted[i].value - segment.slope * sorted[i].mV;
+    }
+    curve.count = count - 1;
+    return true;
+}
+
+/**
+ * @brief Looks up the sensor calibration of a measurement type
+ * @param type "ph", "rx" or other
+ * @return Sensor calibration, nullptr for other types (raw mV)
+ */
+const ADS1015::CalCurve* ADS1015::curveForType(const char* type) const {
+    if (strcmp(type, "ph") == 0) return &_phCurve;
+    if (strcmp(type, "rx") == 0) return &_orpCurve;
+    return nullptr;
+}
+
+/**
+ * @brief Classifies a measurement type string
+ * @param type "ph", "rx" or other
+ * @return Tag that can be kept after the caller's string is gone
+ */
+ADS1015::TypeTag ADS1015::typeTag(const char* type) {
+    if (type == nullptr) return TypeTag::OTHER;
+    if (strcmp(type, "ph") == 0) return TypeTag::PH;
+    if (strcmp(type, "rx") == 0) return TypeTag::ORP;
+    return TypeTag::OTHER;
+}
+
+/**
+ * @brief Temperature compensation of a measurement type as a line
+ * @param type Measurement type
+ * @param scale Receives the factor applied to the calibrated value
+ * @param offset Receives the offset added afterwards
+ * 
+ * pH: (pH - isopotential) * k + isopotential, with the factor k taken
+ * from the compensation table (precomputed by setTemperature()).
+ * ORP: ORP - coefficient * (T - 25) when a coefficient is set.
+ * Both are linear, so they reduce to a scale and an offset.
+ */
+void ADS1015::temperatureTransform(const char* type, float& scale, float& offset) const {
+    scale = 1.0f;
+    offset = 0.0f;
+    if (type == nullptr || !_temperatureCompensationEnabled) return;
+    
+    if (strcmp(type, "ph") == 0) {
+        scale = _tempFactorQ14 / 16384.0f;
+        offset = _isopotential_pH * (1.0f - scale);
+    } else if (strcmp(type, "rx") == 0) {
+        offset = -_orpTempCoefficient * (_currentTemperature - 25.0f);
+    }
+}
+
+/**
+ * @brief Folds gain, calibration and temperature compensation into code segments
+ * @param ch Channel with config.type, calibration, segmentCount and mVPerCode set
+ * 
+ * Called when a reading starts (and when auto-ranging changes its gain),
+ * so the temperature in effect at the start applies to the whole reading.
+ * Breakpoints move from mV to codes, so a conversion compares codes and
+ * does one multiply-add.
+ */
+void ADS1015::prepareTransform(ScanChannel& ch) const {
+    float scale, offset;
+    temperatureTransform(ch.config.type, scale, offset);
+    
+    for (uint8_t i = 0; i < ch.segmentCount; i++) {
+        const CalSegment& segment = ch.calibration[i];
+        CodeSegment& folded = ch.segments[i];
+        folded.fromCode = segment.from_mV / ch.mVPerCode;
+        folded.slope = segment.slope * ch.mVPerCode * scale;
+        folded.offset = segment.offset * scale + offset;
+    }
+}
+
+/**
+ * @brief Converts an ADC code through a channel's calibration
+ * @param ch Channel with its transform prepared
+ * @param code Raw or averaged code
+ * @return Calibrated, temperature compensated value without range limiting
+ * 
+ * The end segments extrapolate beyond the outer calibration points.
+ */
+float ADS1015::codeToValue(const ScanChannel& ch, float code) const {
+    if (ch.segmentCount == 0) return code * ch.mVPerCode;
+    
+    uint8_t i = 0;
+    while (i + 1 < ch.segmentCount && code >= ch.segments[i + 1].fromCode) {
+        i++;
+    }
+    return ch.segments[i].slope * code + ch.segments[i].offset;
+}
+
+/**
+ * @brief Initiates new measurement sequence
+ * @param config Reading configuration (type, samples, timing)
+ * 
+ * Sets up buffers and parameters for new measurement
+ * Non-blocking - call updateReading() to progress
+ */
+void ADS1015::startReading(const PHXConfig& config) {
+    if (_state != PHXState::IDLE) return;
+    
+    // The rolling average persists across readings; it only restarts when
+    // its size or the measurement type changes
+    uint8_t avgBufferSize = constrain(config.avg_buffer, 1, MAX_AVG_BUFFER);
+    TypeTag type = typeTag(config.type);
+    if (avgBufferSize != _avgBufferSize ||
+        (_rollingCount > 0 && type != _rollingType)) {
+        _avgBufferSize = avgBufferSize;
+        resetRollingAverage();
+    }
+    _rollingType = type;
+    
+    beginSingleReading(config, (strcmp(config.type, "ph") == 0) ? &_phCurve : &_orpCurve);
+}
+
+/**
+ * @brief Sets up a single-channel reading and enters COLLECTING
+ * @param config Reading configuration
+ * @param cal Calibration to apply, nullptr for raw mV
+ */
+void ADS1015::beginSingleReading(const PHXConfig& config, const CalCurve* curve) {
+    _config = config;
+    
+    // Unknown signal level: start in the widest range and let the first
+    // conversion pick the gain
+    if (_autoRange && (!_autoRangeKnown || _autoRangeInput != config.input)) {
+        setGain(ADS1015_REG_SET_GAIN0_6_144V);
+        _autoRangeProbe = true;
+    }
+    
+    // Samples are accumulated on the fly; the buffer only limits the
+    // sample count when a robust aggregation needs every sample stored
+    if (_readings != nullptr && _config.aggregation != PHXAggregation::MEAN &&
+        _config.samples > _readingsCapacity) {
+        _config.samples = _readingsCapacity;
+    }
+    
+    // A single reading is a one-channel scan of the configured input at
+    // the sensor gain
+    ScanChannel& ch = _channels[0];
+    ch.config.input = config.input;
+    ch.config.type = config.type;
+    ch.config.gain = _gain;
+    ch.config.cal = nullptr;
+    ch.calibration = (curve != nullptr) ? curve->segments : nullptr;
+    ch.segmentCount = (curve != nullptr) ? curve->count : 0;
+    ch.mVPerCode = _mVPerCode;
+    prepareTransform(ch);
+    _channelCount = 1;
+    _scanMode = false;
+    
+    beginCollecting();
+    setupFilter(_config.filter, _config.filter_hz);
+    
+    // Continuous streaming configures the ADC once for the whole reading.
+    // Otherwise a stream left running (streaming switched off during the
+    // previous reading) must not supply this reading's samples.
+    if (_continuousMode) {
+        startContinuous(config.input);
+    } else {
+        stopContinuous();
+        _conversionPending = false;
+    }
+}
+
+/**
+ * @brief Starts a multi-channel scan
+ * @param channels Channel list (copied, up to MAX_SCAN_CHANNELS entries)
+ * @param count Number of channels in the list
+ * @param samples Samples per channel
+ * @param delay_ms Delay between scan passes
+ * 
+ * Each pass converts every listed channel once, back to back, with its
+ * own gain, so all channels advance together and their readings cover
+ * the same time window. Scans always use single-shot conversions; the
+ * rolling average and raw sample buffer only apply to startReading().
+ */
+void ADS1015::startScan(const PHXChannelConfig* channels, uint8_t count, int samples, int delay_ms) {
+    if (_state != PHXState::IDLE || channels == nullptr || count == 0) return;
+    
+    _channelCount = constrain(count, 1, MAX_SCAN_CHANNELS);
+    for (uint8_t i = 0; i < _channelCount; i++) {
+        ScanChannel& ch = _channels[i];
+        ch.config = channels[i];
+        if (ch.config.cal != nullptr) {
+            // A channel's own two-point calibration lives in the channel;
+            // one that cannot form a line reports millivolts
+            CalCurve own = {0, {}};
+            PHXCalibrationPoint points[2] = {
+                {ch.config.cal->ref1_mV, ch.config.cal->ref1_value},
+                {ch.config.cal->ref2_mV, ch.config.cal->ref2_value}
+            };
+            if (buildCurve(points, 2, PHXCalibrationFit::PIECEWISE, own)) {
+                ch.line = own.segments[0];
+                ch.calibration = &ch.line;
+                ch.segmentCount = own.count;
+            } else {
+                ch.calibration = nullptr;
+                ch.segmentCount = 0;
+            }
+        } else {
+            const CalCurve* curve = curveForType(ch.config.type);  // Other types report millivolts
+            ch.calibration = (curve != nullptr) ? curve->segments : nullptr;
+            ch.segmentCount = (curve != nullptr) ? curve->count : 0;
+        }
+        ch.mVPerCode = millivoltsPerCode(ch.config.gain);
+        prepareTransform(ch);
+    }
+    
+    _config.type = nullptr;
+    _config.samples = samples;
+    _config.delay_ms = delay_ms;
+    _config.avg_buffer = 1;
+    _config.tolerance_mV = 0;
+    _config.aggregation = PHXAggregation::MEAN;
+    _config.filter = PHXFilter::NONE;
+    _config.filter_hz = 0;
+    _config.target_bits = 0;
+    _scanMode = true;
+    
+    // A stream left running by a continuous reading would otherwise
+    // supply the first channel's samples
+    stopContinuous();
+    _conversionPending = false;
+    
+    beginCollecting();
+}
+
+/**
+ * @brief Prepares the per-sample filter for a reading
+ * @param type Filter to apply
+ * @param cutoffHz Cutoff frequency for EMA and LOWPASS
+ * 
+ * Coefficients are derived once per reading from the effective sample
+ * rate: the sample interval (delay_ms) or, when sampling back to back,
+ * the conversion time. Filtering per sample is then integer-only.
+ */
+void ADS1015::setupFilter(PHXFilter type, float cutoffHz) {
+    _filter.type = type;
+    _filter.primed = false;
+    _filter.rateError = false;
+    _filter.count = 0;
+    _filter.settle = 0;
+    _filter.error = 0;
+    resetAccumulator(_filtered);
+    if (type == PHXFilter::NONE) return;
+    
+    unsigned long periodUs = (_sampleIntervalUs > _conversionTimeUs) ? _sampleIntervalUs : _conversionTimeUs;
+    float sampleRate = 1000000.0f / periodUs;
+    
+    switch (type) {
+        case PHXFilter::EMA: {
+            // alpha = 2^-shift closest to the alpha of the requested cutoff,
+            // so the update is a subtraction and a shift
+            float alpha = (cutoffHz > 0) ? 1.0f - expf(-2.0f * (float)M_PI * cutoffHz / sampleRate) : 1.0f;
+            uint8_t shift = 0;
+            while (shift < 12 && alpha < 0.7071f / (1UL << shift)) {
+                shift++;
+            }
+            _filter.shift = shift;
+            _filter.settle = 4U << shift;  // Warm-up ramp plus about two time constants
+            break;
+        }
+        
+        case PHXFilter::LOWPASS: {
+            // RBJ cookbook Butterworth low-pass (Q = 1/sqrt(2)); the cutoff
+            // is limited to where Q14 coefficients stay accurate and stable
+            float fc = constrain(cutoffHz, sampleRate / 200.0f, sampleRate * 0.45f);
+            float w = 2.0f * (float)M_PI * fc / sampleRate;
+            float alpha = sinf(w) * 0.7071f;
+            float a0 = 1.0f + alpha;
+            _filter.a1 = (int32_t)floorf(-2.0f * cosf(w) / a0 * 16384.0f + 0.5f);
+            _filter.a2 = (int32_t)floorf((1.0f - alpha) / a0 * 16384.0f + 0.5f);
+            _filter.b0 = (int32_t)floorf((1.0f - cosf(w)) / 2.0f / a0 * 16384.0f + 0.5f);
+            _filter.b2 = _filter.b0;
+            // Derive b1 from the rounded coefficients so the DC gain is exactly 1
+            _filter.b1 = 16384 + _filter.a1 + _filter.a2 - 2 * _filter.b0;
+            _filter.settle = (uint16_t)ceilf(sampleRate / fc);  // About six time constants
+            break;
+        }
+        
+        case PHXFilter::NOTCH_50HZ:
+        case PHXFilter::NOTCH_60HZ: {
+            // The null is tuned to the sample rate, so the rate must come
+            // from the MCU clock: samples paced by delay_ms with time for
+            // each conversion. Back to back it would follow the ADC
+            // oscillator and bus timing instead. Mains above the Nyquist
+            // frequency is rejected at its alias, which must stay clear of
+            // DC so slow signals pass.
+            float mains = (type == PHXFilter::NOTCH_50HZ) ? 50.0f : 60.0f;
+            float alias = fabsf(mains - sampleRate * floorf(mains / sampleRate + 0.5f));
+            if (_sampleIntervalUs <= _conversionTimeUs || alias < 1.0f || alias < sampleRate / 100.0f) {
+                _filter.type = PHXFilter::NONE;
+                _filter.rateError = true;
+                break;
+            }
+            
+            // Biquad notch: zeros on the unit circle at the mains alias,
+            // poles at radius r set the -3 dB width (a twentieth of the
+            // sample rate, narrower when the alias is close to DC)
+            float w = 2.0f * (float)M_PI * alias / sampleRate;
+            float width = (alias / 2.0f < sampleRate / 20.0f) ? alias / 2.0f : sampleRate / 20.0f;
+            float r = 1.0f - (float)M_PI * width / sampleRate;
+            float c = cosf(w);
+            float gain = (1.0f - 2.0f * r * c + r * r) / (2.0f - 2.0f * c);  // Unity gain at DC
+            _filter.a1 = (int32_t)floorf(-2.0f * r * c * 16384.0f + 0.5f);
+            _filter.a2 = (int32_t)floorf(r * r * 16384.0f + 0.5f);
+            _filter.b0 = (int32_t)floorf(gain * 16384.0f + 0.5f);
+            _filter.b2 = _filter.b0;
+            // b1 keeps the zeros at the mains frequency; the DC gain is
+            // then within 1e-4 of 1
+            _filter.b1 = (int32_t)floorf(-2.0f * c * _filter.b0 + 0.5f);
+            _filter.settle = (uint16_t)ceilf(5.0f / (1.0f - r));  // Five time constants
+            break;
+        }
+        
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Filters one sample
+ * @param code Raw 12-bit ADC code
+ * @return Filtered code
+ * 
+ * Fixed point throughout. The history starts at the first sample, so a
+ * steady input passes without a start-up transient; noise on the first
+ * sample decays with the filter's time constant. Remainders lost to
+ * rounding are carried into the next output.
+ */
+int16_t ADS1015::filterSample(int16_t code) {
+    if (_filter.count < UINT16_MAX) {
+        _filter.count++;
+    }
+    
+    switch (_filter.type) {
+        case PHXFilter::EMA: {
+            if (!_filter.primed) {
+                _filter.state = (int32_t)code * 65536;
+                _filter.ramp = 0;
+                _filter.primed = true;
+            }
+            
+            // Start as a running average and widen to the full smoothing
+            // factor, so a noisy first sample does not bias the output
+            if (_filter.ramp < _filter.shift && _filter.count + 1UL >= (2UL << _filter.ramp)) {
+                _filter.ramp++;
+            }
+            _filter.state += ((int32_t)code * 65536 - _filter.state) >> _filter.ramp;
+            return (int16_t)((_filter.state + 0x8000) >> 16);
+        }
+        
+        case PHXFilter::LOWPASS:
+        case PHXFilter::NOTCH_50HZ:
+        case PHXFilter::NOTCH_60HZ: {
+            int32_t x = (int32_t)code * 8;
+            if (!_filter.primed) {
+                _filter.x1 = _filter.x2 = _filter.y1 = _filter.y2 = x;
+                _filter.primed = true;
+            }
+            // Direct form I: all terms stay below 2^31 for 12-bit codes in Q3
+            int32_t acc = _filter.b0 * x + _filter.b1 * _filter.x1 + _filter.b2 * _filter.x2 -
+                          _filter.a1 * _filter.y1 - _filter.a2 * _filter.y2 + _filter.error;
+            int32_t y = acc >> 14;
+            _filter.error = acc - y * 16384;
+            _filter.x2 = _filter.x1;
+            _filter.x1 = x;
+            _filter.y2 = _filter.y1;
+            _filter.y1 = y;
+            return (int16_t)((y + 4) >> 3);
+        }
+        
+        default:
+            return code;
+    }
+}
+
+/**
+ * @brief Checks whether the next sample is due and schedules the one after
+ * @return True if the sample interval has elapsed
+ * 
+ * The schedule advances by whole intervals, so polling latency does not
+ * stretch the sample period (the notch filter relies on the exact rate).
+ * After a stall of more than one interval it restarts from now.
+ */
+bool ADS1015::sampleDue() {
+    unsigned long now = micros();
+    unsigned long elapsed = now - _lastSampleTime;
+    if (elapsed < _sampleIntervalUs) return false;
+    
+    _lastSampleTime = (elapsed < 2 * _sampleIntervalUs) ? _lastSampleTime + _sampleIntervalUs : now;
+    return true;
+}
+
+/**
+ * @brief Resets per-reading state and enters COLLECTING
+ */
+void ADS1015::beginCollecting() {
+    _sampleIntervalUs = (unsigned long)_config.delay_ms * 1000UL;
+    _currentSample = 0;
+    _scanIndex = 0;
+    _readingComplete = false;
+    _lastError = PHXError::NONE;
+    
+    for (uint8_t i = 0; i < _channelCount; i++) {
+        resetAccumulator(_channels[i].acc);
+        _channels[i].value = 0;
+        _channels[i].error = PHXError::NONE;
+    }
+    
+    _state = PHXState::COLLECTING;
+}
+
+/**
+ * @brief Core measurement state machine with temperature compensation
+ * 
+ * This function implements the non-blocking measurement process:
+ * 1. COLLECTING: Start a conversion at each sample interval and collect it
+ *    once its conversion time has elapsed (never sleeps inside the library)
+ * 2. PROCESSING: Convert voltages to pH/ORP values with optional temperature compensation
+ *    (for every channel of a scan)
+ * 3. IDLE: Measurement complete, result added to the rolling average
+ * 
+ * Calibration (startCalibration()) loops COLLECTING, PROCESSING,
+ * STABILITY_CHECK and SETTLING until consecutive readings agree.
+ * 
+ * Features:
+ * - Online sample statistics (mean, standard deviation, min/max) in O(1) memory
+ * - Integer accumulation of raw codes, converted to mV once per reading
+ * - Two-point calibration application
+ * - Temperature compensation for pH measurements (Pasco 2001 formula)
+ * - Range validation and error reporting
+ * - Hardware alarm callbacks (see enableAlarm())
+ * - Reading and sample callbacks (see setReadingCallback())
+ */
+void ADS1015::updateReading() {
+    // Alarms are reported from here rather than from the interrupt handler,
+    // so the callback may use I2C and Serial
+    if (_alertPending) {
+        _alertPending = false;
+        _alarmTriggered = true;
+        if (_alertCallback != nullptr) {
+            _alertCallback(*this);
+        }
+    }
+    
+    switch (_state) {
+        case PHXState::COLLECTING: {
+            if (_conversionPending) {
+                // Wait for the running conversion without blocking the caller
+                if (!conversionComplete()) break;
+                
+                // Continuous: the ADC free-runs, so only pace the reads
+                if (_continuousRunning && !sampleDue()) break;
+                
+                // Raw codes are accumulated as integers; conversion to mV happens
+                // once per reading in PROCESSING
+                int16_t rawReading = getLastConversionResult();
+                if (_autoRange && !_scanMode && autoRangeSample(rawReading)) {
+                    break;
+                }
+                
+                // The mean, stop rules and ENOB need independent samples, so
+                // they use the raw code; a filter only shapes what is
+                // stored, reported per sample and its spread
+                accumulateSample(_channels[_scanIndex].acc, rawReading);
+                if (!_scanMode && _filter.type != PHXFilter::NONE) {
+                    rawReading = filterSample(rawReading);
+                    if (_filter.count > _filter.settle) {
+                        accumulateSample(_filtered, rawReading);  // Spread of the settled output
+                    }
+                }
+                
+                if (_sampleCallback != nullptr) {
+                    const ScanChannel& ch = _channels[_scanIndex];
+                    _sampleCallback(*this, _scanIndex, rawReading * ch.mVPerCode,
+                                    codeToValue(ch, rawReading));
+                }
+                
+                // Keep raw samples only when the caller provided storage,
+                // as many as it holds
+                if (_readings != nullptr && !_scanMode && _currentSample < _readingsCapacity) {
+                    _readings[_currentSample] = rawReading;
+                }
+                
+                // Next channel of this pass, or the pass is complete
+                if (++_scanIndex >= _channelCount) {
+                    _scanIndex = 0;
+                    _currentSample++;
+                    
+                    // Move to processing when all samples collected, or
+                    // earlier once the mean is known to the requested tolerance
+                    // or resolution
+                    if (_currentSample >= _config.samples ||
+                        (!_scanMode && _config.tolerance_mV > 0 &&
+                         isSettled(_channels[0], _config.tolerance_mV)) ||
+                        (!_scanMode && _config.target_bits > ADC_BITS &&
+                         _currentSample >= MIN_STABLE_SAMPLES &&
+                         _currentSample >= requiredSamples(_channels[0].acc, _config.target_bits))) {
+                        _state = PHXState::PROCESSING;
+                        break;
+                    }
+                }
+                
+                if (_continuousRunning) break;
+            }
+            
+            // Single-shot: start the next conversion in the same call that
+            // collected the previous one, so the ADC never waits for us.
+            // A pass over all channels starts when the sample interval is due
+            // (measured from pass start to pass start); within a pass the
+            // next channel converts right away.
+            if (_scanIndex == 0 && !sampleDue()) break;
+            const ScanChannel& ch = _channels[_scanIndex];
+            startConversion(inputMux(ch.config.input), ch.config.gain);
+            break;
+        }
+            
+        case PHXState::PROCESSING: {
+            // Statistics were accumulated sample by sample while collecting;
+            // this is the only place codes are converted to values
+            for (uint8_t i = 0; i < _channelCount; i++) {
+                ScanChannel& ch = _channels[i];
+                if (ch.acc.validSamples == 0) continue;
+                
+                float code = (float)ch.acc.sum / ch.acc.validSamples;
+                
+                // Robust aggregation works on the stored raw samples
+                if (!_scanMode && _readings != nullptr &&
+                    _config.aggregation != PHXAggregation::MEAN) {
+                    code = aggregateCodes(_readings, _currentSample, _config.aggregation);
+                }
+                ch.value = convertReading(ch, code, ch.error);
+                if (!_scanMode && _filter.rateError && ch.error == PHXError::NONE) {
+                    ch.error = PHXError::FILTER_RATE;
+                }
+                if (_lastError == PHXError::NONE) {
+                    _lastError = ch.error;
+                }
+            }
+            
+            if (_autoRange && !_scanMode) {
+                autoRangeAfterReading();
+            }
+            
+            if (_calibrating) {
+                _lastStats = computeStats(_channels[0]);
+                _state = PHXState::STABILITY_CHECK;
+                break;
+            }
+            
+            if (!_scanMode) {
+                _lastStats = computeStats(_channels[0]);
+                _lastReading = _channels[0].value;
+                
+                // Readings without valid samples report 0 and are not averaged
+                if (_channels[0].acc.validSamples > 0) {
+                    addToRollingAverage(_lastReading);
+                }
+            }
+            
+            _readingComplete = true;
+            _state = PHXState::IDLE;
+            
+            if (_alarmEnabled) {
+                restoreAlarm();
+            }
+            
+            if (_readingCallback != nullptr) {
+                notifyReadingComplete();
+            }
+            break;
+        }
+            
+        case PHXState::STABILITY_CHECK: {
+            // Calibration readings are raw millivolts
+            float current = _channels[0].value;
+            _calReadings++;
+            
+            if (_calReadings >= 2) {
+                float average = (_calPrevious + current) / 2.0f;
+                _calDrift = current - _calPrevious;
+                _calibrationValue = average;
+                
+                if (fabsf(average - _calPrevious) < STABILITY_THRESHOLD &&
+                    fabsf(average - current) < STABILITY_THRESHOLD) {
+                    finishCalibration(PHXError::NONE);
+                    break;
+                }
+            } else {
+                _calibrationValue = current;
+            }
+            _calPrevious = current;
+            
+            if (_calTimeout > 0 && millis() - _calStart >= _calTimeout) {
+                finishCalibration(PHXError::CAL_TIMEOUT);
+                break;
+            }
+            
+            _calSettleStart = millis();
+            _state = PHXState::SETTLING;
+            break;
+        }
+            
+        case PHXState::SETTLING:
+            // Pause between calibration readings without blocking the caller
+            if (millis() - _calSettleStart < CAL_SETTLE_MS) break;
+            beginSingleReading(_calConfig, nullptr);
+            break;
+            
+        case PHXState::IDLE:
+            break;
+    }
+}
+
+/**
+ * @brief Passes the completed reading to the reading callback
+ * 
+ * Results are copied first, so the callback may start the next reading
+ * (which reuses the channel state) from any of its calls.
+ */
+void ADS1015::notifyReadingComplete() {
+    PHXReadingResult results[MAX_SCAN_CHANNELS];
+    uint8_t count = _channelCount;
+    unsigned long timestamp = millis();
+    
+    for (uint8_t i = 0; i < count; i++) {
+        results[i].value = _channels[i].value;
+        results[i].error = _channels[i].error;
+        results[i].timestamp = timestamp;
+        results[i].stats = computeStats(_channels[i]);
+        results[i].channel = i;
+    }
+    
+    for (uint8_t i = 0; i < count; i++) {
+        _readingCallback(*this, results[i]);
+    }
+}
+
+/**
+ * @brief Cancels current measurement
+ * 
+ * Cleans up resources and resets state machine; also aborts a calibration
+ * Useful for aborting long measurements or handling errors
+ */
+void ADS1015::cancelReading() {
+    bool wasRunning = (_state != PHXState::IDLE);
+    
+    _calibrating = false;
+    _conversionPending = false;
+    _scanIndex = 0;
+    _state = PHXState::IDLE;
+    _readingComplete = false;
+    _lastError = PHXError::NONE;
+    
+    if (wasRunning && _alarmEnabled) {
+        restoreAlarm();
+    }
+}
+
+/**
+ * @brief Clears the cross-reading rolling average
  */
-void ADS1015::begin() {
-    Wire.begin();
+void ADS1015::resetRollingAverage() {
+    _readingIndex = 0;
+    _rollingCount = 0;
+    _rollingSum = 0;
+    _rollingAverageReady = false;
 }
 
 /**
- * @brief Sets ADC gain/voltage range
- * @param gain Use predefined gain settings (e.g., ADS1015_REG_SET_GAIN1_4_096V)
- * Higher gain provides better resolution but smaller voltage range
+ * @brief Adds a completed reading to the rolling average
+ * @param value Final reading value
+ * 
+ * Ring buffer with a running sum, so each update is O(1). The sum is
+ * rebuilt from the buffer every time the ring wraps to stop float
+ * rounding from drifting over months of operation.
  */
-void ADS1015::setGain(uint16_t gain) {
-    _gain = gain;
+void ADS1015::addToRollingAverage(float value) {
+    if (_rollingCount == _avgBufferSize) {
+        _rollingSum -= _lastReadings[_readingIndex];
+    } else {
+        _rollingCount++;
+    }
+    _lastReadings[_readingIndex] = value;
+    _rollingSum += value;
+    
+    _readingIndex++;
+    if (_readingIndex >= _avgBufferSize) {
+        _readingIndex = 0;
+        if (_rollingCount == _avgBufferSize) {
+            _rollingSum = 0;
+            for (uint8_t i = 0; i < _avgBufferSize; i++) {
+                _rollingSum += _lastReadings[i];
+            }
+        }
+    }
+    
+    _rollingAverageReady = (_rollingCount == _avgBufferSize);
+    _averageReading = _rollingSum / _rollingCount;
 }
 
 /**
- * @brief Reads voltage from specified ADC channel
- * @param channel ADC input channel (0-3)
- * @return Raw 12-bit ADC value (0-2047)
+ * @brief Uses caller-provided storage for raw samples
+ * @param buffer Sample storage, or nullptr to stop storing raw samples
+ * @param capacity Number of samples the buffer holds
  * 
- * Configures ADC for single-ended measurement on specified channel
- * and returns raw conversion result
+ * The library never allocates sample storage itself. With a buffer the
+ * first capacity raw ADC codes of each reading are also stored there.
+ * Only readings with a robust aggregation are limited to the capacity.
+ * Ignored while a reading is in progress.
  */
-int16_t ADS1015::readADC_SingleEnded(uint8_t channel) {
-    if (channel > 3) return 0;
-
-    // Set up ADC configuration register
-    uint16_t config = _gain |                     // Voltage range
-                     ADS1015_REG_CONFIG_MODE_CONTIN |  // Continuous conversion
-                     ADS1015_REG_CONFIG_DR_1600SPS;    // 1600 samples/second
-
-    // Select input channel
-    config |= (ADS1015_REG_CONFIG_MUX_SINGLE_0 + (channel * 0x1000));
-    config |= ADS1015_REG_CONFIG_OS_SINGLE;      // Start conversion
-
-    writeRegister(_i2cAddress, ADS1015_REG_POINTER_CONFIG, config);
-    delay(1);  // Brief delay for conversion completion
-
-    // Read and return 12-bit result
-    return readRegister(_i2cAddress, ADS1015_REG_POINTER_CONVERT) >> 4;
+void ADS1015::setSampleBuffer(int16_t* buffer, int capacity) {
+    if (_state != PHXState::IDLE) return;
+    
+    if (buffer != nullptr && capacity > 0) {
+        _readings = buffer;
+        _readingsCapacity = capacity;
+    } else {
+        _readings = nullptr;
+        _readingsCapacity = 0;
+    }
 }
 
 /**
- * @brief Performs two-register I2C write
- * @param i2cAddress Device address
- * @param reg Register address
- * @param value 16-bit value to write
- * 
- * Handles I2C protocol for writing 16-bit configuration values
+ * @brief Clears running statistics before a reading
+ * @param acc Accumulator to clear
  */
-void ADS1015::writeRegister(uint8_t i2cAddress, uint8_t reg, uint16_t value) {
-    Wire.beginTransmission(i2cAddress);
-    Wire.write((uint8_t)reg);
-    Wire.write((uint8_t)(value >> 8));    // High byte
-    Wire.write((uint8_t)(value & 0xFF));  // Low byte
-    Wire.endTransmission();
+void ADS1015::resetAccumulator(Accumulator& acc) {
+    acc.validSamples = 0;
+    acc.sum = 0;
+    acc.sumSq = 0;
+    acc.sumTx = 0;
+    acc.min = INT16_MAX;
+    acc.max = INT16_MIN;
 }
 
 /**
- * @brief Reads 16-bit value from ADC register
- * @param i2cAddress Device address
- * @param reg Register to read
- * @return 16-bit register value
+ * @brief Adds one sample to the running statistics
+ * @param acc Accumulator of the sampled channel
+ * @param code Raw 12-bit ADC code
  * 
- * Handles I2C protocol for reading conversion results
+ * Integer-only so it stays cheap on FPU-less MCUs: codes are summed into
+ * an int32_t, their squares and index-weighted codes into int64_t, which
+ * is exact for any realistic sample count
  */
-uint16_t ADS1015::readRegister(uint8_t i2cAddress, uint8_t reg) {
-    Wire.beginTransmission(i2cAddress);
-    Wire.write(reg);
-    Wire.endTransmission();
+void ADS1015::accumulateSample(Accumulator& acc, int16_t code) {
+    acc.sumTx += (int32_t)acc.validSamples * code;  // Sample index 0..n-1
+    acc.validSamples++;
+    acc.sum += code;
+    acc.sumSq += (int32_t)code * code;
     
-    Wire.requestFrom(i2cAddress, (uint8_t)2);
-    return ((Wire.read() << 8) | Wire.read());  // Combine bytes
+    if (code < acc.min) acc.min = code;
+    if (code > acc.max) acc.max = code;
 }
 
 /**
- * @brief Gets stable reading for calibration
- * @param type Measurement type ("ph" or "rx")
- * @return Stable voltage reading in mV
- * 
- * Takes multiple readings until values stabilize within threshold
- * Used during calibration process to ensure accurate reference points
- * 
- * NOTE: Temperature compensation is NOT applied during calibration.
- * This is correct behavior - calibration should capture raw sensor response.
+ * @brief Converts a channel's accumulated codes into statistics in mV
+ * @param ch Scan channel with accumulated samples
+ * @return Mean, standard deviation, min, max and sample count
  */
-float ADS1015::calibratePHXReading(const char* type) {
-    float firstReading, secondReading;
-    
-    // Basic config for calibration readings
-    PHXConfig calConfig = {
-        .type = type,
-        .samples = 100,    // Use 100 samples for accuracy
-        .delay_ms = 10,    // 10ms between samples
-        .avg_buffer = 1    // No averaging during calibration
-    };
+PHXStats ADS1015::computeStats(const ScanChannel& ch) const {
+    const Accumulator& acc = ch.acc;
+    PHXStats stats = {0, 0, 0, 0, acc.validSamples, 0, 0};
     
-    // Take readings until stable (within STABILITY_THRESHOLD)
-    do {
-        // First reading
-        startReading(calConfig);
-        while(getState() != PHXState::IDLE) {
-            updateReading();
-        }
-        firstReading = getLastReading();
-        
-        delay(500);  // Wait between readings
+    if (acc.validSamples > 0) {
+        stats.mean_mV = ((float)acc.sum / acc.validSamples) * ch.mVPerCode;
+        stats.min_mV = acc.min * ch.mVPerCode;
+        stats.max_mV = acc.max * ch.mVPerCode;
+    }
+    if (acc.validSamples > 1) {
+        float variance = varianceCodes(acc);
+        stats.stddev_mV = sqrtf(variance) * ch.mVPerCode;
+        stats.drift_mV = trendCodes(acc) * ch.mVPerCode;
         
-        // Second reading
-        startReading(calConfig);
-        while(getState() != PHXState::IDLE) {
-            updateReading();
+        // Resolution of the mean: an ideal b-bit converter has quantization
+        // noise 2^(12-b) / sqrt(12) codes, the mean has stddev / sqrt(n).
+        // Noise below one quantization step gives no dither, so averaging
+        // cannot resolve beyond the native bits.
+        if (variance * 12.0f > 1.0f) {
+            stats.enob = ADC_BITS + 0.5f * log2f((float)acc.validSamples / (12.0f * variance));
+        } else {
+            stats.enob = ADC_BITS;
         }
-        secondReading = getLastReading();
-        
-    } while(abs((firstReading + secondReading) / 2.0f - firstReading) >= STABILITY_THRESHOLD ||
-            abs((firstReading + secondReading) / 2.0f - secondReading) >= STABILITY_THRESHOLD);
-            
-    return (firstReading + secondReading) / 2.0f;  // Return average
+    } else if (acc.validSamples == 1) {
+        stats.enob = ADC_BITS;
+    }
+    
+    // A filter changes the spread of the samples, which is what it is
+    // there to reduce; the mean, drift and ENOB stay those of the raw
+    // samples. Readings too short for the filter to settle keep the raw spread.
+    if (!_scanMode && _filter.type != PHXFilter::NONE && _filtered.validSamples > 0) {
+        stats.min_mV = _filtered.min * ch.mVPerCode;
+        stats.max_mV = _filtered.max * ch.mVPerCode;
+        stats.stddev_mV = (_filtered.validSamples > 1) ? sqrtf(varianceCodes(_filtered)) * ch.mVPerCode : 0;
+    }
+    return stats;
 }
 
 /**
- * @brief Stores calibration data for pH or ORP
- * @param type Measurement type ("ph" or "rx")
- * @param cal Calibration points and values
+ * @brief Sample variance of the accumulated codes
+ * @param acc Accumulator with at least two samples
+ * @return Variance in codes squared
  * 
- * Stores two-point calibration data for converting voltage to pH or ORP
+ * Exact integer numerator n*sum(x^2) - (sum x)^2, divided by n*(n-1).
  */
-void ADS1015::calibratePHX(const char* type, PHX_Calibration &cal) {
-    if (strcmp(type, "ph") == 0) {
-        ph_cal = cal;
-    } else if (strcmp(type, "rx") == 0) {
-        orp_cal = cal;
-    }
+float ADS1015::varianceCodes(const Accumulator& acc) {
+    int64_t n = acc.validSamples;
+    int64_t numerator = n * acc.sumSq - (int64_t)acc.sum * acc.sum;
+    return (float)numerator / (float)(n * (n - 1));
 }
 
 /**
- * @brief Initiates new measurement sequence
- * @param config Reading configuration (type, samples, timing)
+ * @brief Least-squares trend of the accumulated codes
+ * @param acc Accumulator with at least two samples
+ * @return Fitted change from first to last sample, in codes
  * 
- * Sets up buffers and parameters for new measurement
- * Non-blocking - call updateReading() to progress
+ * Regression of code on sample index t = 0..n-1. The sums over t are
+ * closed-form, so only sum(t*x) has to be accumulated:
+ * slope = (n*sum(tx) - sum(t)*sum(x)) / (n*sum(t^2) - sum(t)^2)
+ *       = 12 * (n*sum(tx) - sum(t)*sum(x)) / (n^2 * (n^2 - 1))
  */
-void ADS1015::startReading(const PHXConfig& config) {
-    if (_state != PHXState::IDLE) return;
-    
-    _config = config;
-    _currentSample = 0;
-    _readingComplete = false;
-    _lastError = PHXError::NONE;
-    
-    // Set up rolling average if requested
-    if (_lastReadings != nullptr) {
-        delete[] _lastReadings;
-    }
-    _avgBufferSize = constrain(config.avg_buffer, 1, MAX_AVG_BUFFER);
-    _lastReadings = new float[_avgBufferSize]();
-    _readingIndex = 0;
-    _rollingAverageReady = false;
-    
-    // Prepare samples buffer
-    if (_readings != nullptr) {
-        delete[] _readings;
-    }
-    _readings = new float[config.samples];
-    
-    _state = PHXState::COLLECTING;
+float ADS1015::trendCodes(const Accumulator& acc) {
+    int64_t n = acc.validSamples;
+    int64_t sumT = n * (n - 1) / 2;
+    int64_t numerator = n * acc.sumTx - sumT * acc.sum;
+    float slope = 12.0f * (float)numerator / ((float)(n * n) * (float)(n * n - 1));
+    return slope * (float)(n - 1);
 }
 
 /**
- * @brief Core measurement state machine with temperature compensation
- * 
- * This function implements the non-blocking measurement process:
- * 1. COLLECTING: Gather voltage samples at specified intervals
- * 2. PROCESSING: Convert voltages to pH/ORP values with optional temperature compensation
- * 3. IDLE: Measurement complete
+ * @brief Combines stored raw samples with a robust estimator
+ * @param codes Raw sample codes (reordered in place)
+ * @param n Number of samples
+ * @param aggregation Estimator to use
+ * @return Estimate in codes
  * 
- * Features:
- * - Voltage range selection based on gain
- * - Sample averaging
- * - Two-point calibration application
- * - Temperature compensation for pH measurements (Pasco 2001 formula)
- * - Range validation and error reporting
+ * All estimators are O(n): order statistics come from selectCode()
+ * instead of a full sort, and everything but the final division is
+ * integer arithmetic.
  */
-void ADS1015::updateReading() {
-    switch (_state) {
-        case PHXState::COLLECTING:
-            if (millis() - _lastSampleTime >= _config.delay_ms) {
-                // Select voltage range based on configured gain
-                float voltageRange;
-                switch(_gain) {
-                    case ADS1015_REG_SET_GAIN0_6_144V: voltageRange = 6.144f; break;
-                    case ADS1015_REG_SET_GAIN1_4_096V: voltageRange = 4.096f; break;
-                    case ADS1015_REG_SET_GAIN2_2_048V: voltageRange = 2.048f; break;
-                    case ADS1015_REG_SET_GAIN4_1_024V: voltageRange = 1.024f; break;
-                    case ADS1015_REG_SET_GAIN8_0_512V: voltageRange = 0.512f; break;
-                    case ADS1015_REG_SET_GAIN16_0_256V: voltageRange = 0.256f; break;
-                    default: voltageRange = 6.144f;
-                }
-                
-                // Get voltage reading
-                int16_t rawReading = readADC_SingleEnded(0);
-                _readings[_currentSample] = (rawReading * voltageRange) / 2048.0f;
-                
-                _lastSampleTime = millis();
-                _currentSample++;
-                
-                // Move to processing when all samples collected
-                if (_currentSample >= _config.samples) {
-                    _state = PHXState::PROCESSING;
-                }
+float ADS1015::aggregateCodes(int16_t* codes, int n, PHXAggregation aggregation) {
+    if (n <= 0) return 0;
+    
+    switch (aggregation) {
+        case PHXAggregation::MEDIAN: {
+            int16_t upper = selectCode(codes, n, n / 2);
+            if (n % 2 != 0) return upper;
+            
+            // Even count: the lower middle is the largest code left of n/2
+            int16_t lower = codes[0];
+            for (int i = 1; i < n / 2; i++) {
+                if (codes[i] > lower) lower = codes[i];
             }
-            break;
+            return (lower + upper) / 2.0f;
+        }
+        
+        case PHXAggregation::TRIMMED_MEAN:
+        case PHXAggregation::WINSORIZED_MEAN: {
+            int trim = (int)((long)n * TRIM_PERCENT / 100);
+            if (trim == 0) break;
             
-        case PHXState::PROCESSING: {
-            // Average valid readings
-            float raw_sum = 0;
-            int validSamples = 0;
+            // Partition so [0, trim) holds the lowest and [n - trim, n) the
+            // highest codes; the middle section is then in between
+            int16_t low = selectCode(codes, n, trim);
+            int16_t high = selectCode(codes + trim, n - trim, n - 2 * trim - 1);
             
-            for (int i = 0; i < _config.samples; i++) {
-                if (!isnan(_readings[i]) && !isinf(_readings[i])) {
-                    raw_sum += _readings[i];
-                    validSamples++;
-                }
+            int32_t sum = 0;
+            for (int i = trim; i < n - trim; i++) {
+                sum += codes[i];
             }
-            
-            // Handle case of no valid readings
-            if (validSamples == 0) {
-                _lastReading = 0;
-                _state = PHXState::IDLE;
-                _readingComplete = true;
-                break;
+            if (aggregation == PHXAggregation::TRIMMED_MEAN) {
+                return (float)sum / (n - 2 * trim);
             }
+            sum += (int32_t)trim * low + (int32_t)trim * high;
+            return (float)sum / n;
+        }
+        
+        case PHXAggregation::HAMPEL: {
+            int16_t median = selectCode(codes, n, n / 2);
             
-            // Convert to millivolts
-            float mV = (raw_sum / validSamples) * 1000.0f;
+            // Store signed deviations in place; the MAD is the median of
+            // their magnitudes
+            for (int i = 0; i < n; i++) {
+                codes[i] -= median;
+            }
+            int16_t mad = selectCode(codes, n, n / 2, true);
             
-            // Get calibration data for measurement type
-            PHX_Calibration* cal = (strcmp(_config.type, "ph") == 0) ? &ph_cal : &orp_cal;
+            // Limit is HAMPEL_K * 1.4826 * MAD (the MAD of normal noise is
+            // 0.6745 sigma), but never below one code of quantization
+            float limit = HAMPEL_K * 1.4826f * mad;
+            int32_t maxDeviation = (limit < 1.0f) ? 1 : (int32_t)limit;
             
-            // Apply calibration if available
-            if (abs(cal->ref2_mV - cal->ref1_mV) > 0.001f) {
-                // Calculate using two-point calibration formula
-                float rawValue = cal->ref1_value + 
-                                (cal->ref2_value - cal->ref1_value) * 
-                                (mV - cal->ref1_mV) / 
-                                (cal->ref2_mV - cal->ref1_mV);
-                
-                // Apply temperature compensation only for pH measurements
-                if (strcmp(_config.type, "ph") == 0 && 
-                    _temperatureCompensationEnabled && 
-                    isValidTemperature(_currentTemperature)) {
-                    
-                    _lastReading = applyTemperatureCompensation(rawValue, _currentTemperature);
-                } else {
-                    _lastReading = rawValue;
-                }
-                
-                // Apply range limits and set error flags
-                if (strcmp(_config.type, "ph") == 0) {
-                    // pH range validation (0-14)
-                    if (_lastReading < 0) {
-                        _lastReading = 0;
-                        _lastError = PHXError::PH_LOW;
-                    }
-                    else if (_lastReading > 14) {
-                        _lastReading = 14;
-                        _lastError = PHXError::PH_HIGH;
-                    }
-                    else {
-                        _lastError = PHXError::NONE;
-                    }
-                }
-                else if (strcmp(_config.type, "rx") == 0) {
-                    // ORP range validation (0-1000mV)
-                    if (_lastReading < 0) {
-                        _lastReading = 0;
-                        _lastError = PHXError::ORP_LOW;
-                    }
-                    else if (_lastReading > 1000) {
-                        _lastReading = 1000;
-                        _lastError = PHXError::ORP_HIGH;
-                    }
-                    else {
-                        _lastError = PHXError::NONE;
-                    }
+            int32_t sum = 0;
+            for (int i = 0; i < n; i++) {
+                int32_t deviation = codes[i];
+                if (deviation <= maxDeviation && deviation >= -maxDeviation) {
+                    sum += deviation;  // Outliers count as the median (deviation 0)
                 }
-            } else {
-                _lastReading = mV;  // Use raw mV if not calibrated
+                codes[i] += median;
             }
-            
-            // Clean up and complete
-            delete[] _readings;
-            _readings = nullptr;
-            _readingComplete = true;
-            _state = PHXState::IDLE;
-            break;
+            return median + (float)sum / n;
         }
-            
-        case PHXState::IDLE:
+        
+        default:
             break;
     }
+    
+    int32_t sum = 0;
+    for (int i = 0; i < n; i++) {
+        sum += codes[i];
+    }
+    return (float)sum / n;
 }
 
 /**
- * @brief Cancels current measurement
+ * @brief Finds the k-th smallest code (quickselect)
+ * @param codes Codes to search (reordered in place)
+ * @param n Number of codes
+ * @param k Zero-based rank to find
+ * @param byMagnitude Rank by absolute value instead of signed value
+ * @return The k-th smallest code (its magnitude when byMagnitude)
  * 
- * Cleans up resources and resets state machine
- * Useful for aborting long measurements or handling errors
+ * Wirth's selection algorithm: average O(n), and its two-sided
+ * partitioning stays fast with the many duplicate codes typical of a
+ * quiet 12-bit input. Afterwards every code before index k ranks at or
+ * below codes[k] and every code after it at or above.
  */
-void ADS1015::cancelReading() {
-    if (_readings != nullptr) {
-        delete[] _readings;
-        _readings = nullptr;
+int16_t ADS1015::selectCode(int16_t* codes, int n, int k, bool byMagnitude) {
+    int left = 0;
+    int right = n - 1;
+    
+    while (left < right) {
+        int16_t pivot = byMagnitude ? abs(codes[k]) : codes[k];
+        int i = left;
+        int j = right;
+        
+        do {
+            while ((byMagnitude ? abs(codes[i]) : codes[i]) < pivot) i++;
+            while (pivot < (byMagnitude ? abs(codes[j]) : codes[j])) j--;
+            if (i <= j) {
+                int16_t swap = codes[i];
+                codes[i] = codes[j];
+                codes[j] = swap;
+                i++;
+                j--;
+            }
+        } while (i <= j);
+        
+        if (j < k) left = i;
+        if (k < i) right = j;
     }
-    _state = PHXState::IDLE;
-    _readingComplete = false;
-    _lastError = PHXError::NONE;
+    return byMagnitude ? abs(codes[k]) : codes[k];
+}
+
+/**
+ * @brief Sequential stability test for early termination
+ * @param ch Channel being collected
+ * @param tolerance_mV Required precision of the mean
+ * @return True when the mean is known to tolerance_mV and the input is not drifting
+ * 
+ * Two conditions, both in squared codes so no square root is needed:
+ * - Standard error: STABLE_Z * stddev / sqrt(n) <= tolerance
+ * - Trend: the fitted drift across the reading <= tolerance
+ * The trend test catches a settling probe, whose mean would otherwise
+ * look precise while it is still moving.
+ */
+bool ADS1015::isSettled(const ScanChannel& ch, float tolerance_mV) const {
+    const Accumulator& acc = ch.acc;
+    if (acc.validSamples < MIN_STABLE_SAMPLES) return false;
+    
+    float toleranceCodes = tolerance_mV / ch.mVPerCode;
+    float toleranceSq = toleranceCodes * toleranceCodes;
+    
+    // Variance of the mean
+    float meanVariance = varianceCodes(acc) / acc.validSamples;
+    if (STABLE_Z * STABLE_Z * meanVariance > toleranceSq) return false;
+    
+    float drift = trendCodes(acc);
+    return drift * drift <= toleranceSq;
+}
+
+/**
+ * @brief Oversampling ratio needed for a target resolution
+ * @param acc Accumulator holding the samples so far (at least two)
+ * @param targetBits Effective resolution wanted, ADC_BITS+1 to MAX_TARGET_BITS
+ * @return Number of samples whose mean reaches targetBits (may exceed any sample limit)
+ * 
+ * Each extra bit halves the quantization step, so the standard error
+ * stddev / sqrt(N) must reach 2^(12-b) / sqrt(12) codes:
+ * N = 12 * variance * 4^(b-12). The noise floor is measured from the
+ * samples collected so far. When it is below one quantization step the
+ * classic 4^(b-12) is returned, although without dither the samples
+ * agree and the mean cannot gain resolution (see PHXStats::enob).
+ */
+float ADS1015::requiredSamples(const Accumulator& acc, uint8_t targetBits) {
+    if (targetBits > MAX_TARGET_BITS) targetBits = MAX_TARGET_BITS;
+    float ratio = (float)(1L << (2 * (targetBits - ADC_BITS)));  // 4^(b-12)
+    
+    float noise = 12.0f * varianceCodes(acc);
+    if (noise <= 1.0f) return ratio;
+    return noise * ratio;
+}
+
+/**
+ * @brief Converts an averaged ADC code into its measurement value
+ * @param ch Channel with its transform prepared by prepareTransform()
+ * @param code Averaged (or aggregated) raw code
+ * @param error Receives the range validation result
+ * @return Calibrated, temperature compensated and range limited value
+ */
+float ADS1015::convertReading(const ScanChannel& ch, float code, PHXError& error) const {
+    error = PHXError::NONE;
+    
+    // Gain, calibration and pH temperature compensation, all precomputed
+    float value = codeToValue(ch, code);
+    
+    // Raw mV if not calibrated
+    if (ch.segmentCount == 0) {
+        return value;
+    }
+    
+    const char* type = ch.config.type;
+    if (strcmp(type, "ph") == 0) {
+        // pH range validation (0-14)
+        if (value < 0) {
+            value = 0;
+            error = PHXError::PH_LOW;
+        }
+        else if (value > 14) {
+            value = 14;
+            error = PHXError::PH_HIGH;
+        }
+    }
+    else if (strcmp(type, "rx") == 0) {
+        // ORP range validation (0-1000mV)
+        if (value < 0) {
+            value = 0;
+            error = PHXError::ORP_LOW;
+        }
+        else if (value > 1000) {
+            value = 1000;
+            error = PHXError::ORP_HIGH;
+        }
+    }
+    return value;
+}
+
+/**
+ * @brief Gets the result of one scan channel
+ * @param index Position in the channel list passed to startScan()
+ * @return Channel value (pH, ORP mV or raw mV depending on type)
+ */
+float ADS1015::getScanReading(uint8_t index) const {
+    return (index < _channelCount) ? _channels[index].value : 0;
+}
+
+/**
+ * @brief Gets the range validation result of one scan channel
+ * @param index Position in the channel list passed to startScan()
+ * @return Channel error
+ */
+PHXError ADS1015::getScanError(uint8_t index) const {
+    return (index < _channelCount) ? _channels[index].error : PHXError::NONE;
+}
+
+/**
+ * @brief Gets the sample statistics of one scan channel
+ * @param index Position in the channel list passed to startScan()
+ * @return Channel statistics in mV
+ */
+PHXStats ADS1015::getScanStats(uint8_t index) const {
+    if (index >= _channelCount) {
+        PHXStats empty = {0, 0, 0, 0, 0, 0, 0};
+        return empty;
+    }
+    return computeStats(_channels[index]);
 }
 
 // ========================================
@@ -366,7 +1964,7 @@ void ADS1015::cancelReading() {
  * accuracy for swimming pool monitoring and other applications where
  * temperature varies from the calibration conditions.
  * 
- * Only affects pH measurements - ORP readings are not temperature compensated.
+ * ORP readings are only corrected with setORPTemperatureCoefficient().
  */
 void ADS1015::enableTemperatureCompensation(bool enabled) {
     _temperatureCompensationEnabled = enabled;
@@ -387,6 +1985,7 @@ void ADS1015::enableTemperatureCompensation(bool enabled) {
 void ADS1015::setTemperature(float temperature) {
     if (isValidTemperature(temperature)) {
         _currentTemperature = temperature;
+        updateTemperatureFactor();
         // Clear any previous temperature error
         if (_lastError == PHXError::TEMP_INVALID) {
             _lastError = PHXError::NONE;
@@ -398,6 +1997,58 @@ void ADS1015::setTemperature(float temperature) {
     }
 }
 
+/**
+ * @brief Replace the pH compensation factors
+ * @param factors TEMP_TABLE_SIZE factors at 0, 5, ..., 50°C, or nullptr for Pasco 2001
+ * 
+ * The default table holds the Pasco 2001 formula:
+ * pH_compensated = ((pH_raw - 7) × (273.15 + current_temp)) / (273.15 + 25) + 7
+ * 
+ * This formula:
+ * - Uses pH 7 as the reference point (minimal temperature dependence)
+ * - Normalizes all readings to 25°C standard temperature
+ * - Is specifically optimized for swimming pool pH ranges (6.8-8.2)
+ * 
+ * Factors are stored in Q14 fixed point (1.0 = 16384).
+ */
+void ADS1015::setTemperatureTable(const float* factors) {
+    for (uint8_t i = 0; i < TEMP_TABLE_SIZE; i++) {
+        float factor = (factors != nullptr) ?
+                       factors[i] :
+                       (273.15f + i * TEMP_TABLE_STEP) / (273.15f + 25.0f);
+        _tempTable[i] = (uint16_t)constrain(factor * 16384.0f + 0.5f, 0.0f, 65535.0f);
+    }
+    updateTemperatureFactor();
+}
+
+/**
+ * @brief Set the pH at which the probe voltage does not change with temperature
+ * @param pH Isopotential point, clamped to 0-14
+ */
+void ADS1015::setIsopotentialPoint(float pH) {
+    _isopotential_pH = constrain(pH, 0.0f, 14.0f);
+}
+
+/**
+ * @brief Interpolates the compensation table at the current temperature
+ * 
+ * Fixed point with 0.1°C resolution, once per temperature change, so
+ * readings only pick up the result.
+ */
+void ADS1015::updateTemperatureFactor() {
+    const int32_t stepTenths = TEMP_TABLE_STEP * 10;
+    int32_t tenths = (int32_t)(_currentTemperature * 10.0f + 0.5f);  // 0..500
+    int32_t index = tenths / stepTenths;
+    
+    if (index >= TEMP_TABLE_SIZE - 1) {
+        _tempFactorQ14 = _tempTable[TEMP_TABLE_SIZE - 1];
+        return;
+    }
+    int32_t fraction = tenths - index * stepTenths;
+    int32_t delta = (int32_t)_tempTable[index + 1] - _tempTable[index];
+    _tempFactorQ14 = (uint16_t)(_tempTable[index] + delta * fraction / stepTenths);
+}
+
 /**
  * @brief Get current temperature setting
  * @return Current temperature in Celsius
@@ -414,32 +2065,6 @@ bool ADS1015::isTemperatureCompensationEnabled() const {
     return _temperatureCompensationEnabled;
 }
 
-/**
- * @brief Apply temperature compensation using Pasco 2001 formula
- * @param pH_raw Raw pH reading before compensation
- * @param current_temp Current temperature in Celsius
- * @return Temperature compensated pH value normalized to 25°C
- * 
- * Implements the scientifically proven Pasco 2001 formula:
- * pH_compensated = ((pH_raw - 7) × (273.15 + current_temp)) / (273.15 + 25) + 7
- * 
- * This formula:
- * - Uses pH 7 as the reference point (minimal temperature dependence)
- * - Normalizes all readings to 25°C standard temperature
- * - Accounts for the actual physics of ion activity vs temperature
- * - Is specifically optimized for swimming pool pH ranges (6.8-8.2)
- * 
- * Example: A pH 7.5 reading at 30°C becomes pH 7.56 when compensated to 25°C
- */
-float ADS1015::applyTemperatureCompensation(float pH_raw, float current_temp) {
-    // Pasco 2001 formula for temperature compensation
-    // pH_corrected = ((pH_init - 7) × (273.15 + temp)) / (273.15 + 25) + 7
-    
-    float pH_corrected = ((pH_raw - 7.0f) * (273.15f + current_temp)) / (273.15f + 25.0f) + 7.0f;
-    
-    return pH_corrected;
-}
-
 /**
  * @brief Validate temperature is within reasonable range
  * @param temperature Temperature to validate
@@ -452,9 +2077,84 @@ float ADS1015::applyTemperatureCompensation(float pH_raw, float current_temp) {
  * Temperatures outside this range are likely sensor errors or inappropriate
  * for the intended pH measurement applications.
  */
-bool ADS1015::isValidTemperature(float temperature) {
+bool ADS1015::isValidTemperature(float temperature) const {
     // Reasonable temperature range for swimming pools and water measurements
     return (temperature >= 0.0f && temperature <= 50.0f);
 }
 
+// ========================================
+// Shared I2C Bus Scheduler
+// ========================================
+
+/**
+ * @brief Creates a scheduler for one I2C bus
+ * @param wire Bus the registered sensors are attached to
+ */
+PHXBus::PHXBus(TwoWire& wire) : _wire(wire) {
+}
+
+/**
+ * @brief Registers a sensor on this bus
+ * @param device Sensor to schedule (must outlive the scheduler)
+ * @return False if MAX_DEVICES sensors are already registered
+ * 
+ * The sensor is switched to this scheduler's bus
+ */
+bool PHXBus::addDevice(ADS1015& device) {
+    if (_deviceCount >= MAX_DEVICES) return false;
+    
+    device._wire = &_wire;
+    _devices[_deviceCount++] = &device;
+    return true;
+}
+
+/**
+ * @brief Initializes the bus once for all registered sensors
+ * @param clockHz I2C clock in Hz, or 0 to keep the core default
+ */
+void PHXBus::begin(uint32_t clockHz) {
+    _wire.begin();
+    if (clockHz > 0) {
+        _wire.setClock(clockHz);
+    }
+    for (uint8_t i = 0; i < _deviceCount; i++) {
+        _devices[i]->_pointer = 0xFF;  // Register pointer state unknown
+    }
+}
+
+/**
+ * @brief Starts the same reading on every registered sensor
+ * @param config Reading configuration
+ */
+void PHXBus::startReadings(const PHXConfig& config) {
+    for (uint8_t i = 0; i < _deviceCount; i++) {
+        _devices[i]->startReading(config);
+    }
+}
+
+/**
+ * @brief Advances all registered sensors by one step
+ * 
+ * Each sensor collects its finished conversion and immediately starts the
+ * next one, so in one pass every chip gets a conversion running before
+ * the pass returns. The chips then convert in parallel and four sensors
+ * take about as long as one.
+ */
+void PHXBus::update() {
+    for (uint8_t i = 0; i < _deviceCount; i++) {
+        _devices[i]->updateReading();
+    }
+}
+
+/**
+ * @brief Checks whether every registered sensor is idle
+ * @return True when no sensor has a reading in progress
+ */
+bool PHXBus::isIdle() const {
+    for (uint8_t i = 0; i < _deviceCount; i++) {
+        if (_devices[i]->getState() != PHXState::IDLE) return false;
+    }
+    return true;
+}
+
 // End of APAPHX_ADS1015.cpp implementation
\ No newline at end of file
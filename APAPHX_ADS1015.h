@@ -64,6 +64,8 @@
 // Pointer Register
 #define ADS1015_REG_POINTER_CONVERT 0x00  // Conversion register
 #define ADS1015_REG_POINTER_CONFIG  0x01  // Configuration register
+#define ADS1015_REG_POINTER_LOWTHRESH 0x02  // Lo_thresh register
+#define ADS1015_REG_POINTER_HITHRESH  0x03  // Hi_thresh register
 
 // Config Register settings
 #define ADS1015_REG_CONFIG_OS_SINGLE    0x8000  // Start single conversion
@@ -71,6 +73,10 @@
 #define ADS1015_REG_CONFIG_MUX_SINGLE_1 0x5000  // Single-ended AIN1
 #define ADS1015_REG_CONFIG_MUX_SINGLE_2 0x6000  // Single-ended AIN2
 #define ADS1015_REG_CONFIG_MUX_SINGLE_3 0x7000  // Single-ended AIN3
+#define ADS1015_REG_CONFIG_MUX_DIFF_0_1 0x0000  // Differential AIN0 - AIN1
+#define ADS1015_REG_CONFIG_MUX_DIFF_0_3 0x1000  // Differential AIN0 - AIN3
+#define ADS1015_REG_CONFIG_MUX_DIFF_1_3 0x2000  // Differential AIN1 - AIN3
+#define ADS1015_REG_CONFIG_MUX_DIFF_2_3 0x3000  // Differential AIN2 - AIN3
 
 // Programmable gain settings
 #define ADS1015_REG_SET_GAIN0_6_144V    0x0000  // +/-6.144V range = Gain 2/3
@@ -81,15 +87,31 @@
 #define ADS1015_REG_SET_GAIN16_0_256V   0x0A00  // +/-0.256V range = Gain 16
 
 #define ADS1015_REG_CONFIG_MODE_CONTIN  0x0000  // Continuous conversion mode
-#define ADS1015_REG_CONFIG_DR_1600SPS   0x0080  // 1600 samples per second
+#define ADS1015_REG_CONFIG_MODE_SINGLE  0x0100  // Single-shot mode (power-down after conversion)
+#define ADS1015_REG_CONFIG_DR_128SPS    0x0000  // 128 samples per second
+#define ADS1015_REG_CONFIG_DR_250SPS    0x0020  // 250 samples per second
+#define ADS1015_REG_CONFIG_DR_490SPS    0x0040  // 490 samples per second
+#define ADS1015_REG_CONFIG_DR_920SPS    0x0060  // 920 samples per second
+#define ADS1015_REG_CONFIG_DR_1600SPS   0x0080  // 1600 samples per second (default)
+#define ADS1015_REG_CONFIG_DR_2400SPS   0x00A0  // 2400 samples per second
+#define ADS1015_REG_CONFIG_DR_3300SPS   0x00C0  // 3300 samples per second
+
+#define ADS1015_REG_CONFIG_CMODE_WINDOW 0x0010  // Window comparator (traditional when clear)
+#define ADS1015_REG_CONFIG_CLAT_LATCH   0x0004  // ALERT/RDY stays asserted until the conversion register is read
+#define ADS1015_REG_CONFIG_CQUE_1CONV   0x0000  // Assert ALERT/RDY after one conversion
+#define ADS1015_REG_CONFIG_CQUE_2CONV   0x0001  // Assert ALERT/RDY after two conversions
+#define ADS1015_REG_CONFIG_CQUE_4CONV   0x0002  // Assert ALERT/RDY after four conversions
+#define ADS1015_REG_CONFIG_CQUE_NONE    0x0003  // Comparator disabled, ALERT/RDY high impedance
 
 /**
  * @brief Measurement state machine states
  */
 enum class PHXState {
-    IDLE,       ///< Ready for new measurement
-    COLLECTING, ///< Collecting samples
-    PROCESSING  ///< Processing collected data
+    IDLE,           ///< Ready for new measurement
+    COLLECTING,     ///< Collecting samples
+    PROCESSING,     ///< Processing collected data
+    SETTLING,       ///< Calibration: pause before the next calibration reading
+    STABILITY_CHECK ///< Calibration: comparing consecutive calibration readings
 };
 
 /**
@@ -101,7 +123,48 @@ enum class PHXError {
     PH_HIGH,      ///< pH above 14
     ORP_LOW,      ///< ORP below 0mV
     ORP_HIGH,     ///< ORP above 1000mV
-    TEMP_INVALID  ///< Invalid temperature reading (outside 0-50°C range)
+    TEMP_INVALID, ///< Invalid temperature reading (outside 0-50°C range)
+    CAL_TIMEOUT,  ///< Calibration readings did not settle before the timeout
+    FILTER_RATE   ///< Notch filter cannot reach mains at this sample rate; samples were not filtered
+};
+
+/**
+ * @brief ADC input selection (single-ended or differential)
+ */
+enum class PHXInput : uint8_t {
+    AIN0,      ///< Single-ended AIN0 (default)
+    AIN1,      ///< Single-ended AIN1
+    AIN2,      ///< Single-ended AIN2
+    AIN3,      ///< Single-ended AIN3
+    DIFF_0_1,  ///< Differential AIN0 - AIN1
+    DIFF_0_3,  ///< Differential AIN0 - AIN3
+    DIFF_1_3,  ///< Differential AIN1 - AIN3
+    DIFF_2_3   ///< Differential AIN2 - AIN3
+};
+
+/**
+ * @brief How the samples of a reading are combined
+ * 
+ * Everything except MEAN needs raw sample storage (setSampleBuffer() or
+ * ADS1015Fixed) and falls back to MEAN without it.
+ */
+enum class PHXAggregation : uint8_t {
+    MEAN,             ///< Arithmetic mean (default)
+    MEDIAN,           ///< Middle sample
+    TRIMMED_MEAN,     ///< Mean without the lowest and highest TRIM_PERCENT of samples
+    WINSORIZED_MEAN,  ///< Mean with the outer TRIM_PERCENT clamped to the remaining extremes
+    HAMPEL            ///< Mean after replacing samples beyond HAMPEL_K scaled MADs by the median
+};
+
+/**
+ * @brief Digital filter applied to every sample of a reading
+ */
+enum class PHXFilter : uint8_t {
+    NONE,       ///< Raw samples (default)
+    EMA,        ///< Single-pole exponential moving average, cutoff filter_hz
+    LOWPASS,    ///< Second-order Butterworth low-pass (biquad), cutoff filter_hz
+    NOTCH_50HZ, ///< Rejects 50 Hz mains (needs delay_ms longer than the conversion time)
+    NOTCH_60HZ  ///< Rejects 60 Hz mains (needs delay_ms longer than the conversion time)
 };
 
 /**
@@ -114,6 +177,22 @@ struct PHX_Calibration {
     float ref2_value;  ///< Second reference value (pH 7 or 650mV)
 };
 
+/**
+ * @brief One point of a multi-point calibration
+ */
+struct PHXCalibrationPoint {
+    float mV;          ///< Probe reading in the standard (see calibratePHXReading())
+    float value;       ///< Value of the standard (pH or ORP mV)
+};
+
+/**
+ * @brief How a multi-point calibration maps mV to values
+ */
+enum class PHXCalibrationFit : uint8_t {
+    PIECEWISE,      ///< Straight lines between neighbouring points, extrapolated beyond
+    LEAST_SQUARES   ///< One line fitted through all points
+};
+
 /**
  * @brief Reading configuration structure
  */
@@ -121,27 +200,141 @@ struct PHXConfig {
     const char* type;  ///< Measurement type ("ph" or "rx")
     int samples;       ///< Number of samples to collect
     int delay_ms;      ///< Delay between samples
-    uint8_t avg_buffer;///< Size of rolling average buffer (1-10)
+    uint8_t avg_buffer;///< Readings in the rolling average (1-10), see getAverageReading()
+    PHXInput input;    ///< ADC input (defaults to AIN0 when omitted)
+    float tolerance_mV;///< End early once the mean is known to this (0 = always take all samples)
+    PHXAggregation aggregation;  ///< Sample combination (defaults to MEAN when omitted)
+    PHXFilter filter;  ///< Per-sample filter (defaults to NONE when omitted)
+    float filter_hz;   ///< Cutoff frequency for EMA and LOWPASS
+    uint8_t target_bits;///< Oversample to this effective resolution (13-16, 0 = off)
+};
+
+/**
+ * @brief One channel of a multi-channel scan
+ */
+struct PHXChannelConfig {
+    PHXInput input;              ///< ADC input (single-ended or differential)
+    const char* type;            ///< "ph", "rx", or any other type to report raw mV
+    uint16_t gain;               ///< Gain for this channel (ADS1015_REG_SET_GAINx)
+    const PHX_Calibration* cal;  ///< Channel calibration, nullptr for the sensor's "ph"/"rx" calibration
+};
+
+/**
+ * @brief Sample statistics behind the last reading
+ * 
+ * With a PHXConfig::filter, stddev_mV, min_mV and max_mV describe the
+ * filtered samples; everything else describes the unfiltered samples.
+ */
+struct PHXStats {
+    float mean_mV;     ///< Mean of valid samples
+    float stddev_mV;   ///< Sample standard deviation
+    float min_mV;      ///< Smallest valid sample
+    float max_mV;      ///< Largest valid sample
+    int validSamples;  ///< Number of finite samples
+    float drift_mV;    ///< Linear trend across the reading (fitted last minus first sample)
+    float enob;        ///< Effective number of bits of the mean (12 = single-conversion resolution)
 };
 
+/**
+ * @brief Completed reading passed to the reading callback
+ */
+struct PHXReadingResult {
+    float value;              ///< Final value (pH, ORP mV or raw mV depending on type)
+    PHXError error;           ///< Range validation result
+    unsigned long timestamp;  ///< millis() when the reading completed
+    PHXStats stats;           ///< Sample statistics in mV
+    uint8_t channel;          ///< Scan channel index (0 for startReading())
+};
+
+/**
+ * @brief Progress of a running calibration
+ */
+struct PHXCalibrationProgress {
+    uint8_t percent;          ///< Samples collected of the current calibration reading (0-100)
+    uint16_t readings;        ///< Calibration readings completed so far
+    float drift_mV;           ///< Difference between the last two readings
+    unsigned long elapsed_ms; ///< Time since startCalibration()
+};
+
+/**
+ * @brief I2C bus usage counters for benchmarking
+ */
+struct PHXBusStats {
+    uint32_t transactions;  ///< Completed I2C transactions (writes and reads)
+    uint32_t bytes;         ///< Bytes on the bus, including address bytes
+};
+
+/**
+ * @brief Hardware threshold alarm watched by the ADS1015 comparator
+ */
+struct PHXAlarmConfig {
+    const char* type;  ///< "ph", "rx", or any other type for limits in raw mV
+    float low;         ///< Lower limit (pH, ORP mV or raw mV)
+    float high;        ///< Upper limit (pH, ORP mV or raw mV)
+    PHXInput input;    ///< Input to watch
+    uint8_t faults;    ///< Consecutive out-of-window conversions before ALERT (1, 2 or 4)
+    bool latching;     ///< Keep ALERT asserted until clearAlarm()
+};
+
+class ADS1015;
+class PHXBus;
+
+/// Called from updateReading() after the ALERT pin reported an alarm
+typedef void (*PHXAlertCallback)(ADS1015& sensor);
+
+/// Called from updateReading() when a reading (or scan channel) completes
+typedef void (*PHXReadingCallback)(ADS1015& sensor, const PHXReadingResult& result);
+
+/// Called from updateReading() for every collected sample
+typedef void (*PHXSampleCallback)(ADS1015& sensor, uint8_t channel, float mV, float value);
+
 /**
  * @brief ADS1015 ADC controller for pH/ORP measurements with temperature compensation
  */
 class ADS1015 {
+    friend class PHXBus;
+
 public:
     static const uint8_t MAX_AVG_BUFFER = 10;
+    static const uint8_t MAX_SCAN_CHANNELS = 4;
+    static const uint8_t MAX_CAL_POINTS = 5;        ///< Points of a multi-point calibration
+    static const uint8_t TEMP_TABLE_SIZE = 11;      ///< Compensation factors at 0, 5, ..., 50°C
+    static const uint8_t TEMP_TABLE_STEP = 5;       ///< °C between compensation table entries
     static constexpr float STABILITY_THRESHOLD = 0.5f;
+    static const uint8_t READY_TIMEOUT_FACTOR = 4;   ///< Missed ALERT/RDY fallback, in conversion times
+    static const unsigned long CAL_SETTLE_MS = 500;      ///< Pause between calibration readings
+    static const int MIN_STABLE_SAMPLES = 16;            ///< Fewest samples before a reading may end early
+    static constexpr float STABLE_Z = 2.0f;              ///< Confidence of PHXConfig::tolerance_mV (~95%)
+    static const uint8_t TRIM_PERCENT = 10;              ///< Samples trimmed/winsorized at each end
+    static constexpr float HAMPEL_K = 3.0f;              ///< Hampel outlier limit in scaled MADs
+    static const uint8_t ADC_BITS = 12;                  ///< Native resolution of one conversion
+    static const uint8_t MAX_TARGET_BITS = 16;           ///< Highest PHXConfig::target_bits
+    static const uint8_t AUTO_RANGE_WIDEN_PERCENT = 95;  ///< Widen when a sample exceeds this share of full scale
+    static const uint8_t AUTO_RANGE_TIGHTEN_PERCENT = 80;///< Tighten when the peak fits this share of the tighter range
+    static const uint8_t ALARM_RANGE_PERCENT = 95;       ///< Alarm limits stay below this share of the comparator's range
+    static const unsigned long CAL_TIMEOUT_MS = 120000;  ///< Default calibration timeout
 
     /**
      * @brief Construct a new ADS1015 instance
      * @param i2cAddress I2C address of the ADS1015
+     * @param wire I2C bus the ADS1015 is attached to (e.g. Wire1)
      */
-    ADS1015(uint8_t i2cAddress);
+    ADS1015(uint8_t i2cAddress, TwoWire& wire = Wire);
 
     /**
      * @brief Initialize the ADS1015
+     * @param clockHz I2C clock in Hz (0 keeps the core default)
+     */
+    void begin(uint32_t clockHz = 0);
+
+    /**
+     * @brief Initialize the ADS1015 on another I2C bus
+     * @param wire I2C bus the ADS1015 is attached to
+     * @param clockHz I2C clock in Hz (0 keeps the core default)
      */
-    void begin();
+    void begin(TwoWire& wire, uint32_t clockHz = 0);
+
+    TwoWire& getWire() const { return *_wire; }
 
     /**
      * @brief Set the ADC gain
@@ -149,13 +342,205 @@ public:
      */
     void setGain(uint16_t gain);
 
+    /**
+     * @brief Get the ADC gain
+     * @return Current ADS1015_REG_SET_GAINx setting (follows auto-ranging)
+     */
+    uint16_t getGain() const { return _gain; }
+
+    /**
+     * @brief Enable or disable automatic gain selection for readings
+     * @param enabled True to pick the gain from the measured signal
+     * 
+     * Readings (and calibration readings) then use the tightest range the
+     * signal fits in: the first reading on an input starts with a probe
+     * conversion, later readings use the peak of the previous one. A
+     * sample near full scale restarts the reading one range wider.
+     * Hysteresis: ranges tighten only when the peak is below
+     * AUTO_RANGE_TIGHTEN_PERCENT of the tighter range and widen above
+     * AUTO_RANGE_WIDEN_PERCENT of the current one.
+     */
+    void enableAutoRange(bool enabled);
+
+    /**
+     * @brief Check if automatic gain selection is enabled
+     * @return True if enabled, false if disabled
+     */
+    bool isAutoRangeEnabled() const { return _autoRange; }
+
+    /**
+     * @brief Set the ADC data rate
+     * @param rate Data rate setting (use ADS1015_REG_CONFIG_DR_xSPS defines)
+     * 
+     * Lower rates integrate longer and are less noisy; higher rates allow
+     * faster bursts. With delay_ms = 0 readings sample at this rate.
+     */
+    void setDataRate(uint16_t rate);
+
+    /**
+     * @brief Get the ADC data rate setting
+     * @return Data rate setting (ADS1015_REG_CONFIG_DR_xSPS)
+     */
+    uint16_t getDataRate() const { return _dataRate; }
+
+    /**
+     * @brief Get the time one conversion takes at the current data rate
+     * @return Conversion time in microseconds, including oscillator tolerance
+     */
+    unsigned long getConversionTimeUs() const { return _conversionTimeUs; }
+
     /**
      * @brief Read single-ended ADC value
      * @param channel ADC channel (0-3)
-     * @return int16_t Raw ADC value
+     * @return int16_t Raw ADC value (-2048 to 2047)
      */
     int16_t readADC_SingleEnded(uint8_t channel);
 
+    /**
+     * @brief Start a single-shot conversion without waiting for the result
+     * @param channel ADC channel (0-3)
+     */
+    void startADC_SingleEnded(uint8_t channel);
+
+    /**
+     * @brief Read a single-ended or differential input
+     * @param input Input selection
+     * @return int16_t Raw ADC value (-2048 to 2047)
+     */
+    int16_t readADC(PHXInput input);
+
+    /**
+     * @brief Start a single-shot conversion on a single-ended or differential input
+     * @param input Input selection
+     */
+    void startADC(PHXInput input);
+
+    /**
+     * @brief Check whether the started conversion has finished
+     * @return True once the conversion time has elapsed (no I2C traffic)
+     */
+    bool conversionComplete() const;
+
+    /**
+     * @brief Fetch the result of the last started conversion
+     * @return int16_t Raw ADC value
+     * 
+     * With an alarm enabled, a single-shot conversion started by startADC()
+     * pauses the comparator; fetching its result re-arms it.
+     */
+    int16_t getLastConversionResult();
+
+    /**
+     * @brief Start continuous conversion on a channel
+     * @param channel ADC channel (0-3)
+     * 
+     * Writes the config register only if it differs from the running one.
+     * Results are then fetched with getLastConversionResult() as 2-byte reads.
+     * Does nothing while an alarm is enabled: the comparator owns the
+     * continuous conversions (use disableAlarm() first).
+     */
+    void startContinuous(uint8_t channel);
+    void startContinuous(PHXInput input);
+
+    /**
+     * @brief Stop continuous conversion (ADC powers down)
+     * 
+     * Does nothing while an alarm is enabled.
+     */
+    void stopContinuous();
+
+    /**
+     * @brief Enable or disable continuous streaming for readings
+     * @param enabled True to stream, false for single-shot conversions (default)
+     * 
+     * In streaming mode startReading() configures the ADC once and every
+     * sample is a single 2-byte read instead of a config write, pointer
+     * write and read.
+     */
+    void enableContinuousMode(bool enabled);
+
+    /**
+     * @brief Check if continuous streaming is enabled
+     * @return True if enabled, false if disabled
+     */
+    bool isContinuousModeEnabled() const;
+
+    // Conversion-ready (ALERT/RDY pin) methods
+    /**
+     * @brief Enable or disable ALERT/RDY conversion-ready signalling
+     * @param enabled True to use the ALERT/RDY pin, false for time-based polling
+     * 
+     * Programs Hi_thresh/Lo_thresh so the ADS1015 pulls ALERT/RDY low when a
+     * conversion finishes. Attach your own interrupt to the pin (FALLING edge)
+     * and call notifyConversionReady() from it; samples are then fetched only
+     * after the ADC signalled new data. Call after begin().
+     */
+    void enableConversionReady(bool enabled);
+    
+    /**
+     * @brief Signal that the ALERT/RDY pin reported a finished conversion
+     * 
+     * Safe to call from an interrupt handler.
+     */
+    void notifyConversionReady() { _conversionReady = true; }
+    
+    /**
+     * @brief Check if ALERT/RDY conversion-ready signalling is enabled
+     * @return True if enabled, false if disabled
+     */
+    bool isConversionReadyEnabled() const;
+
+    // Hardware threshold alarm (ALERT/RDY pin) methods
+    /**
+     * @brief Watch an input with the built-in window comparator
+     * @param alarm Limits, input, fault count and latching
+     * @return False while a reading is running or conversion-ready signalling is
+     *         enabled, or if a limit lies outside the widest input range (6.144V)
+     * 
+     * The limits are converted through the current calibration (and
+     * temperature compensation for pH) into ADC codes for Hi_thresh and
+     * Lo_thresh, and the ADC is left converting continuously at the current
+     * data rate. The comparator uses its own gain, the tightest range that
+     * holds both limits, so setGain() and auto-ranging do not affect it. The ADS1015 pulls ALERT/RDY low when a conversion
+     * falls outside the window; attach your own interrupt to the pin
+     * (FALLING edge) and call notifyAlert() from it.
+     * 
+     * Readings pause the comparator and restore it when they finish, so the
+     * limits follow calibration and temperature changes made meanwhile. If
+     * such a change moves a limit outside the widest range, the alarm is
+     * disabled; check isAlarmEnabled().
+     */
+    bool enableAlarm(const PHXAlarmConfig& alarm);
+    
+    /**
+     * @brief Stop the comparator and power the ADC down
+     */
+    void disableAlarm();
+    
+    /**
+     * @brief Signal that the ALERT/RDY pin reported an alarm
+     * 
+     * Safe to call from an interrupt handler. The callback runs on the next
+     * updateReading() call.
+     */
+    void notifyAlert() { _alertPending = true; }
+    
+    /**
+     * @brief Set the function called when an alarm is reported
+     * @param callback Alarm handler, or nullptr for none
+     */
+    void setAlertCallback(PHXAlertCallback callback) { _alertCallback = callback; }
+    
+    /**
+     * @brief Acknowledge an alarm
+     * 
+     * Clears isAlarmTriggered() and releases a latched ALERT/RDY pin.
+     */
+    void clearAlarm();
+    
+    bool isAlarmEnabled() const { return _alarmEnabled; }
+    bool isAlarmTriggered() const { return _alarmTriggered; }
+
     /**
      * @brief Store calibration data
      * @param type Measurement type ("ph" or "rx")
@@ -164,11 +549,65 @@ public:
     void calibratePHX(const char* type, PHX_Calibration &cal);
 
     /**
-     * @brief Get stable calibration reading
+     * @brief Store a calibration with three or more standards
      * @param type Measurement type ("ph" or "rx")
-     * @return float Stable reading value
+     * @param points Calibration points in any order (2 to MAX_CAL_POINTS)
+     * @param count Number of points
+     * @param fit PIECEWISE follows every point, LEAST_SQUARES averages their errors
+     * @return False if the points cannot form a calibration (too few or too
+     *         many, or two points at the same mV); the type is then uncalibrated
+     * 
+     * The segments are precomputed here and folded with the gain and
+     * temperature compensation when a reading starts. Converting a reading
+     * then finds its segment with at most count - 2 comparisons and costs
+     * one multiply-add. With two points both fits equal calibratePHX().
+     */
+    bool calibratePHXPoints(const char* type, const PHXCalibrationPoint* points, uint8_t count,
+                            PHXCalibrationFit fit = PHXCalibrationFit::PIECEWISE);
+
+    /**
+     * @brief Get stable calibration reading (blocking)
+     * @param type Measurement type ("ph" or "rx")
+     * @param input Input the probe is connected to
+     * @return float Stable reading in mV (best value so far after a timeout)
+     * 
+     * Runs startCalibration() to completion. Check getLastError() for
+     * PHXError::CAL_TIMEOUT.
+     */
+    float calibratePHXReading(const char* type, PHXInput input = PHXInput::AIN0);
+
+    /**
+     * @brief Start a non-blocking calibration reading
+     * @param type Measurement type ("ph" or "rx")
+     * @param input Input the probe is connected to
+     * @param timeout_ms Give up after this long (0 = never)
+     * 
+     * Takes readings of up to 100 samples CAL_SETTLE_MS apart until two consecutive
+     * readings agree within STABILITY_THRESHOLD. Progress with
+     * updateReading() like any reading; the state returns to IDLE when done.
+     * cancelReading() aborts. Readings use the raw probe voltage, so
+     * neither calibration nor temperature compensation is applied.
+     */
+    void startCalibration(const char* type, PHXInput input = PHXInput::AIN0,
+                          unsigned long timeout_ms = CAL_TIMEOUT_MS);
+
+    /**
+     * @brief Check if a calibration is running
+     * @return True from startCalibration() until it settles, times out or is cancelled
+     */
+    bool isCalibrating() const { return _calibrating; }
+
+    /**
+     * @brief Get progress of the running (or last) calibration
+     * @return Readings taken, current reading progress, drift and elapsed time
+     */
+    PHXCalibrationProgress getCalibrationProgress() const;
+
+    /**
+     * @brief Get the result of the last calibration
+     * @return Stable voltage in mV (best value so far after a timeout)
      */
-    float calibratePHXReading(const char* type);
+    float getCalibrationReading() const { return _calibrationValue; }
 
     /**
      * @brief Start a new reading sequence
@@ -176,6 +615,19 @@ public:
      */
     void startReading(const PHXConfig& config);
 
+    /**
+     * @brief Start a multi-channel scan
+     * @param channels Channel list (copied; calibrations are referenced)
+     * @param count Number of channels (1-4)
+     * @param samples Samples per channel
+     * @param delay_ms Delay between scan passes
+     * 
+     * One instance round-robins all listed channels, each with its own type,
+     * gain and calibration. Progress with updateReading() as usual and read
+     * the results with getScanReading()/getScanError()/getScanStats().
+     */
+    void startScan(const PHXChannelConfig* channels, uint8_t count, int samples, int delay_ms);
+
     /**
      * @brief Update ongoing reading process
      */
@@ -186,17 +638,90 @@ public:
      */
     void cancelReading();
     
+    /**
+     * @brief Set the function called when a reading completes
+     * @param callback Completion handler, or nullptr for none
+     * 
+     * Runs from updateReading() once the sensor is idle again, so the
+     * handler may start the next reading. Scans call it once per channel.
+     * With a callback there is no need to wait for IDLE: call
+     * updateReading() from loop() or a scheduler tick and handle results
+     * as they arrive.
+     */
+    void setReadingCallback(PHXReadingCallback callback) { _readingCallback = callback; }
+    
+    /**
+     * @brief Set the function called for every collected sample
+     * @param callback Sample handler, or nullptr for none
+     * 
+     * Receives the scan channel index, the sample in millivolts and the
+     * sample converted like a reading (calibration and temperature
+     * compensation, no range limiting). Keep it short; it runs inside the
+     * sampling loop.
+     */
+    void setSampleCallback(PHXSampleCallback callback) { _sampleCallback = callback; }
+    
+    /**
+     * @brief Store raw sample codes in caller-provided storage
+     * @param buffer Sample storage, or nullptr to stop storing samples
+     * @param capacity Number of samples the buffer holds
+     * 
+     * Readings never need sample storage: statistics are accumulated per
+     * sample. With a buffer, the first capacity samples of each reading
+     * are stored; MEAN readings may take more samples than that. Robust
+     * aggregation (PHXConfig::aggregation) requires a buffer, is limited
+     * to capacity samples and reorders them. Must be called while idle.
+     */
+    void setSampleBuffer(int16_t* buffer, int capacity);
+    
+    /**
+     * @brief Clear the rolling average of completed readings
+     * 
+     * The rolling average (PHXConfig::avg_buffer readings) persists across
+     * readings and restarts on its own only when avg_buffer or the
+     * measurement type changes.
+     */
+    void resetRollingAverage();
+    
     // Temperature compensation methods
     /**
      * @brief Enable or disable temperature compensation for pH measurements
      * @param enabled True to enable, false to disable
      * 
      * Temperature compensation uses the Pasco 2001 formula to normalize
-     * pH readings to 25°C standard temperature. Only affects pH measurements,
-     * not ORP readings. Disabled by default for backward compatibility.
+     * pH readings to 25°C standard temperature. ORP readings are only
+     * corrected when setORPTemperatureCoefficient() sets a coefficient.
+     * Disabled by default for backward compatibility.
      */
     void enableTemperatureCompensation(bool enabled);
     
+    /**
+     * @brief Replace the pH compensation factors
+     * @param factors TEMP_TABLE_SIZE factors at 0, 5, ..., 50°C, or nullptr for Pasco 2001
+     * 
+     * A compensated pH is (pH - isopotential) * factor + isopotential, with
+     * the factor interpolated at the current temperature in 0.1°C steps.
+     * Use the probe's own temperature response when the datasheet gives
+     * one; the default is the Pasco 2001 factor (273.15 + T) / 298.15.
+     */
+    void setTemperatureTable(const float* factors);
+    
+    /**
+     * @brief Set the pH at which the probe voltage does not change with temperature
+     * @param pH Isopotential point (default 7, clamped to 0-14)
+     */
+    void setIsopotentialPoint(float pH);
+    float getIsopotentialPoint() const { return _isopotential_pH; }
+    
+    /**
+     * @brief Correct ORP readings to 25°C
+     * @param mVPerDegree ORP change per °C above 25°C, 0 to disable (default)
+     * 
+     * With temperature compensation enabled, ORP readings report
+     * ORP - mVPerDegree * (temperature - 25).
+     */
+    void setORPTemperatureCoefficient(float mVPerDegree) { _orpTempCoefficient = mVPerDegree; }
+    
     /**
      * @brief Set current temperature for compensation calculations
      * @param temperature Current temperature in Celsius (valid range: 0-50°C)
@@ -223,11 +748,35 @@ public:
     PHXState getState() const { return _state; }
     bool isReadingComplete() const { return _readingComplete; }
     float getLastReading() const { return _lastReading; }
+    float getAverageReading() const { return _averageReading; }
+    bool isRollingAverageReady() const { return _rollingAverageReady; }
     PHXError getLastError() const { return _lastError; }
+    const PHXStats& getLastStats() const { return _lastStats; }
+    
+    // Scan results (index into the channel list passed to startScan())
+    float getScanReading(uint8_t index) const;
+    PHXError getScanError(uint8_t index) const;
+    PHXStats getScanStats(uint8_t index) const;
+    
+    // Benchmarking
+    /**
+     * @brief Get I2C bus usage since the last resetBusStats()
+     * @return Transaction and byte counters
+     */
+    const PHXBusStats& getBusStats() const { return _busStats; }
+    
+    /**
+     * @brief Reset the I2C bus usage counters
+     */
+    void resetBusStats() { _busStats = {0, 0}; }
 
 private:
     uint8_t _i2cAddress;
+    TwoWire* _wire = &Wire;             ///< Bus the sensor is attached to
     uint16_t _gain = ADS1015_REG_SET_GAIN0_6_144V;
+    float _mVPerCode = 3.0f;            ///< Millivolts per code for _gain (6.144V / 2048)
+    uint16_t _dataRate = ADS1015_REG_CONFIG_DR_1600SPS;
+    unsigned long _conversionTimeUs = 700;  ///< 1600 SPS period plus oscillator tolerance
     PHXState _state = PHXState::IDLE;
     PHXError _lastError = PHXError::NONE;
     bool _readingComplete = false;
@@ -236,36 +785,269 @@ private:
     // Temperature compensation variables
     bool _temperatureCompensationEnabled = false;  ///< Temperature compensation enable flag
     float _currentTemperature = 25.0f;             ///< Current temperature in Celsius (default 25°C)
+    uint16_t _tempTable[TEMP_TABLE_SIZE];          ///< pH compensation factor per TEMP_TABLE_STEP, Q14
+    uint16_t _tempFactorQ14 = 16384;               ///< _tempTable interpolated at _currentTemperature
+    float _isopotential_pH = 7.0f;                 ///< pH with no temperature dependence
+    float _orpTempCoefficient = 0.0f;              ///< ORP mV per °C, 0 = no ORP correction
+    
+    /// Measurement type of a "ph"/"rx"/other string, for keeping beyond a reading
+    enum class TypeTag : uint8_t {
+        PH,
+        ORP,
+        OTHER
+    };
+    
+    /// Calibration line value = slope * mV + offset, used from from_mV upwards
+    struct CalSegment {
+        float from_mV;                  ///< Lower end (ignored for the first segment)
+        float slope;
+        float offset;
+    };
     
-    PHX_Calibration ph_cal = {0, 0, 4, 7};
-    PHX_Calibration orp_cal = {0, 0, 475, 650};
+    /// Precomputed calibration, segments ordered by mV
+    struct CalCurve {
+        uint8_t count;                  ///< Segments in use, 0 = report millivolts
+        CalSegment segments[MAX_CAL_POINTS - 1];
+    };
+    CalCurve _phCurve = {0, {}};        ///< Built by calibratePHX()/calibratePHXPoints()
+    CalCurve _orpCurve = {0, {}};
     
     PHXConfig _config;
-    float* _readings = nullptr;
-    float* _lastReadings = nullptr;
+    int16_t* _readings = nullptr;
+    int _readingsCapacity = 0;          ///< Samples _readings can hold
+    PHXStats _lastStats = {0, 0, 0, 0, 0, 0, 0};
+    
+    /// Running integer statistics of one channel's raw codes
+    struct Accumulator {
+        int validSamples;   ///< Samples accumulated so far
+        int32_t sum;        ///< Sum of raw codes
+        int64_t sumSq;      ///< Sum of squared raw codes
+        int64_t sumTx;      ///< Sum of sample index times raw code (trend)
+        int16_t min;        ///< Smallest raw code
+        int16_t max;        ///< Largest raw code
+    };
+    
+    /// Calibration segment folded with gain and temperature: value = slope * code + offset
+    struct CodeSegment {
+        float fromCode;                 ///< Lower end (ignored for the first segment)
+        float slope;
+        float offset;
+    };
+    
+    /// Per-channel scan state; a single reading uses channel 0
+    struct ScanChannel {
+        PHXChannelConfig config;
+        const CalSegment* calibration;  ///< Resolved calibration, in mV
+        uint8_t segmentCount;           ///< 0 = report millivolts
+        CalSegment line;                ///< Storage for a channel's own two-point calibration
+        float mVPerCode;                ///< Scale for config.gain
+        CodeSegment segments[MAX_CAL_POINTS - 1];  ///< calibration folded by prepareTransform()
+        Accumulator acc;
+        float value;                    ///< Result after PROCESSING
+        PHXError error;                 ///< Range validation result
+    };
+    
+    /// Fixed-point state of the per-sample filter (single readings only)
+    struct FilterState {
+        PHXFilter type;
+        bool primed;                    ///< History initialized from the first sample
+        uint8_t shift;                  ///< EMA smoothing factor 2^-shift
+        uint8_t ramp;                   ///< EMA shift during warm-up (grows to shift)
+        uint16_t count;                 ///< Samples filtered so far (saturates)
+        uint16_t settle;                ///< Samples until the start-up transient has decayed
+        bool rateError;                 ///< Notch requested at a rate it cannot reach
+        int32_t b0, b1, b2, a1, a2;     ///< Biquad coefficients (Q14)
+        int32_t x1, x2, y1, y2;         ///< Biquad history (codes in Q3)
+        int32_t state;                  ///< EMA output (codes in Q16)
+        int32_t error;                  ///< Truncation remainder fed into the next output
+    };
+    
+    ScanChannel _channels[MAX_SCAN_CHANNELS];
+    FilterState _filter;
+    Accumulator _filtered;              ///< Filtered samples of a single reading (spread only)
+    uint8_t _channelCount = 1;          ///< Channels in the current scan
+    uint8_t _scanIndex = 0;             ///< Channel converting in the current pass
+    bool _scanMode = false;             ///< Current reading was started by startScan()
+    float _lastReadings[MAX_AVG_BUFFER];  ///< Ring buffer of completed readings
     uint8_t _avgBufferSize = 1;
     int _currentSample = 0;
     uint8_t _readingIndex = 0;
     bool _rollingAverageReady = false;
-    unsigned long _lastSampleTime = 0;
+    TypeTag _rollingType = TypeTag::OTHER;  ///< Measurement type held in the rolling average
+    uint8_t _rollingCount = 0;          ///< Readings currently in the ring buffer
+    float _rollingSum = 0;              ///< Running sum of the ring buffer
+    float _averageReading = 0;          ///< Rolling average of completed readings
+    unsigned long _lastSampleTime = 0;      ///< Last sample time in microseconds
+    unsigned long _sampleIntervalUs = 0;    ///< Requested sample interval in microseconds
+    bool _conversionPending = false;
+    unsigned long _conversionStart = 0;
+    bool _continuousMode = false;       ///< Readings stream in continuous mode
+    bool _continuousRunning = false;    ///< ADC currently free-running
+    uint16_t _continuousConfig = 0;     ///< Config written for continuous mode
+    uint8_t _pointer = 0xFF;            ///< Cached register pointer (0xFF = unknown)
+    bool _conversionReadyMode = false;  ///< Completion signalled by ALERT/RDY pin
+    volatile bool _conversionReady = false;  ///< Set by notifyConversionReady()
+    uint16_t _comparatorQueue = ADS1015_REG_CONFIG_CQUE_NONE;  ///< COMP_QUE bits for every config write
+    PHXAlarmConfig _alarm;              ///< Comparator alarm restored after readings
+    bool _alarmEnabled = false;
+    bool _alarmTriggered = false;       ///< Alarm reported and not yet cleared
+    volatile bool _alertPending = false;  ///< Set by notifyAlert()
+    PHXAlertCallback _alertCallback = nullptr;
+    PHXReadingCallback _readingCallback = nullptr;
+    PHXSampleCallback _sampleCallback = nullptr;
     
-    void writeRegister(uint8_t i2cAddress, uint8_t reg, uint16_t value);
-    uint16_t readRegister(uint8_t i2cAddress, uint8_t reg);
+    // Auto-ranging
+    bool _autoRange = false;
+    bool _autoRangeProbe = false;       ///< Next sample only selects the gain
+    bool _autoRangeKnown = false;       ///< Signal level of _autoRangeInput is known
+    PHXInput _autoRangeInput = PHXInput::AIN0;
     
-    /**
-     * @brief Apply temperature compensation using Pasco 2001 formula
-     * @param pH_raw Raw pH reading before compensation
-     * @param current_temp Current temperature in Celsius
-     * @return Temperature compensated pH value normalized to 25°C
-     */
-    float applyTemperatureCompensation(float pH_raw, float current_temp);
+    // Non-blocking calibration
+    bool _calibrating = false;
+    PHXConfig _calConfig;               ///< Configuration of the calibration readings
+    unsigned long _calStart = 0;        ///< millis() at startCalibration()
+    unsigned long _calTimeout = 0;      ///< 0 = no timeout
+    unsigned long _calSettleStart = 0;  ///< millis() when the current pause started
+    uint16_t _calReadings = 0;          ///< Calibration readings completed
+    float _calPrevious = 0;             ///< Previous calibration reading in mV
+    float _calDrift = 0;                ///< Last minus previous calibration reading
+    float _calibrationValue = 0;        ///< Calibration result in mV
+    PHXBusStats _busStats = {0, 0};
+    
+    bool writeRegister(uint8_t i2cAddress, uint8_t reg, uint16_t value);
+    uint16_t readRegister(uint8_t i2cAddress, uint8_t reg);
+    uint16_t buildConfig(uint16_t mux, uint16_t gain, uint16_t mode) const;
+    static uint16_t inputMux(PHXInput input);
+    void startConversion(uint16_t mux, uint16_t gain);
+    bool alarmOwnsADC() const;
+    void beginCollecting();
+    void beginSingleReading(const PHXConfig& config, const CalCurve* curve);
+    void finishCalibration(PHXError error);
+    static float millivoltsPerCode(uint16_t gain);
+    static uint8_t gainIndex(uint16_t gain);
+    static uint16_t gainSetting(uint8_t index);
+    static uint8_t fittingGainIndex(float peak_mV, uint8_t percent);
+    bool autoRangeSample(int16_t code);
+    void autoRangeAfterReading();
+    static void resetAccumulator(Accumulator& acc);
+    static void accumulateSample(Accumulator& acc, int16_t code);
+    PHXStats computeStats(const ScanChannel& ch) const;
+    static float trendCodes(const Accumulator& acc);
+    static float varianceCodes(const Accumulator& acc);
+    bool sampleDue();
+    void setupFilter(PHXFilter type, float cutoffHz);
+    int16_t filterSample(int16_t code);
+    static float aggregateCodes(int16_t* codes, int n, PHXAggregation aggregation);
+    static int16_t selectCode(int16_t* codes, int n, int k, bool byMagnitude = false);
+    bool isSettled(const ScanChannel& ch, float tolerance_mV) const;
+    static float requiredSamples(const Accumulator& acc, uint8_t targetBits);
+    static bool buildCurve(const PHXCalibrationPoint* points, uint8_t count,
+                           PHXCalibrationFit fit, CalCurve& curve);
+    static TypeTag typeTag(const char* type);
+    const CalCurve* curveForType(const char* type) const;
+    void temperatureTransform(const char* type, float& scale, float& offset) const;
+    void updateTemperatureFactor();
+    void prepareTransform(ScanChannel& ch) const;
+    float codeToValue(const ScanChannel& ch, float code) const;
+    float convertReading(const ScanChannel& ch, float code, PHXError& error) const;
+    void addToRollingAverage(float value);
+    bool restoreAlarm();
+    void notifyReadingComplete();
+    float alarmLimitMilliVolts(float limit, const CalCurve* curve) const;
     
     /**
      * @brief Validate temperature is within reasonable range
      * @param temperature Temperature to validate
      * @return True if temperature is between 0-50°C, false otherwise
      */
-    bool isValidTemperature(float temperature);
+    bool isValidTemperature(float temperature) const;
+};
+
+/**
+ * @brief Schedules several ADS1015 sensors sharing one I2C bus
+ * 
+ * Owns the bus initialization and advances all registered sensors in one
+ * pass, so their conversions overlap instead of running one after another:
+ * @code
+ * PHXBus bus(Wire);
+ * bus.addDevice(ads1015PH);
+ * bus.addDevice(ads1015RX);
+ * bus.begin(400000);
+ * 
+ * bus.startReadings(config);
+ * while (!bus.isIdle()) {
+ *     bus.update();
+ * }
+ * @endcode
+ */
+class PHXBus {
+public:
+    static const uint8_t MAX_DEVICES = 4;  ///< One per ADS1015 address
+
+    /**
+     * @brief Construct a scheduler for one I2C bus
+     * @param wire Bus the sensors are attached to
+     */
+    PHXBus(TwoWire& wire = Wire);
+
+    /**
+     * @brief Register a sensor (switches it to this bus)
+     * @param device Sensor to schedule
+     * @return False if the scheduler is full
+     */
+    bool addDevice(ADS1015& device);
+
+    /**
+     * @brief Initialize the bus for all registered sensors
+     * @param clockHz I2C clock in Hz (0 keeps the core default)
+     */
+    void begin(uint32_t clockHz = 0);
+
+    /**
+     * @brief Start the same reading on every registered sensor
+     * @param config Reading configuration
+     */
+    void startReadings(const PHXConfig& config);
+
+    /**
+     * @brief Advance every registered sensor by one step
+     */
+    void update();
+
+    /**
+     * @brief Check whether all registered sensors are idle
+     * @return True when no reading is in progress
+     */
+    bool isIdle() const;
+
+    uint8_t getDeviceCount() const { return _deviceCount; }
+    ADS1015& getDevice(uint8_t index) { return *_devices[index]; }
+
+private:
+    TwoWire& _wire;
+    ADS1015* _devices[MAX_DEVICES];
+    uint8_t _deviceCount = 0;
+};
+
+/**
+ * @brief ADS1015 controller with compile-time raw sample storage
+ * @tparam N Raw samples kept per reading (and the most a robust aggregation uses)
+ * 
+ * Keeps the raw sample codes of each reading inside the object:
+ * @code
+ * ADS1015Fixed<100> pHSensor(ADDRESS_49);
+ * ADS1015Fixed<100> orpSensor(ADDRESS_48, Wire1);  // Second I2C bus
+ * @endcode
+ */
+template <int N>
+class ADS1015Fixed : public ADS1015 {
+public:
+    ADS1015Fixed(uint8_t i2cAddress, TwoWire& wire = Wire) : ADS1015(i2cAddress, wire) {
+        setSampleBuffer(_storage, N);
+    }
+
+private:
+    int16_t _storage[N];
 };
 
 #endif // APAPHX_ADS1015_H
\ No newline at end of file
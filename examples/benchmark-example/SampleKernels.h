@@ -0,0 +1,99 @@
+/**
+ * Per-sample statistics kernels for the benchmark sketch and the host
+ * benchmark (extras/host/bench/bench_sample_path.cpp).
+ *
+ * FloatKernel is the v1.1.0 sample path: pick the voltage range for the
+ * gain, convert the code to volts and update float Welford statistics.
+ * IntegerKernel is the current path (ADS1015::accumulateSample()): add
+ * the raw code to integer sums, convert once at the end.
+ *
+ * Both work on codes already read from the ADC, so timing them measures
+ * only the accumulate/convert work, without I2C.
+ */
+
+#ifndef APAPHX_SAMPLE_KERNELS_H
+#define APAPHX_SAMPLE_KERNELS_H
+
+#include "APAPHX_ADS1015.h"
+
+struct FloatKernel {
+    uint16_t gain;
+    int validSamples;
+    float mean, m2, min, max;  // Volts
+
+    void reset(uint16_t adcGain) {
+        gain = adcGain;
+        validSamples = 0;
+        mean = 0;
+        m2 = 0;
+        min = INFINITY;
+        max = -INFINITY;
+    }
+
+    void add(int16_t rawReading) {
+        float voltageRange;
+        switch (gain) {
+            case ADS1015_REG_SET_GAIN0_6_144V: voltageRange = 6.144f; break;
+            case ADS1015_REG_SET_GAIN1_4_096V: voltageRange = 4.096f; break;
+            case ADS1015_REG_SET_GAIN2_2_048V: voltageRange = 2.048f; break;
+            case ADS1015_REG_SET_GAIN4_1_024V: voltageRange = 1.024f; break;
+            case ADS1015_REG_SET_GAIN8_0_512V: voltageRange = 0.512f; break;
+            case ADS1015_REG_SET_GAIN16_0_256V: voltageRange = 0.256f; break;
+            default: voltageRange = 6.144f;
+        }
+        float voltage = (rawReading * voltageRange) / 2048.0f;
+        if (isnan(voltage) || isinf(voltage)) return;
+
+        validSamples++;
+        float delta = voltage - mean;
+        mean += delta / validSamples;
+        m2 += delta * (voltage - mean);
+        if (voltage < min) min = voltage;
+        if (voltage > max) max = voltage;
+    }
+
+    float meanMilliVolts() const { return mean * 1000.0f; }
+    float stddevMilliVolts() const {
+        return validSamples > 1 ? sqrtf(m2 / (validSamples - 1)) * 1000.0f : 0.0f;
+    }
+};
+
+struct IntegerKernel {
+    float mVPerCode;
+    int validSamples;
+    int32_t sum;
+    int64_t sumSq;
+    int64_t sumTx;
+    int16_t min, max;
+
+    void reset(float adcMVPerCode) {
+        mVPerCode = adcMVPerCode;
+        validSamples = 0;
+        sum = 0;
+        sumSq = 0;
+        sumTx = 0;
+        min = INT16_MAX;
+        max = INT16_MIN;
+    }
+
+    void add(int16_t code) {
+        sumTx += (int32_t)validSamples * code;
+        validSamples++;
+        sum += code;
+        sumSq += (int32_t)code * code;
+        if (code < min) min = code;
+        if (code > max) max = code;
+    }
+
+    float meanMilliVolts() const {
+        return validSamples > 0 ? (float)sum / validSamples * mVPerCode : 0.0f;
+    }
+    float stddevMilliVolts() const {
+        if (validSamples < 2) return 0.0f;
+        int64_t n = validSamples;
+        float variance = (float)(n * sumSq - (int64_t)sum * sum) / (float)(n * (n - 1));
+        return sqrtf(variance) * mVPerCode;
+    }
+};
+
+#endif // APAPHX_SAMPLE_KERNELS_H
@@ -0,0 +1,244 @@
+/**
+ * APAPHX Benchmark Example
+ * Measures the cost of a reading cycle for a sweep of PHXConfig shapes:
+ * - I2C transactions and bytes per sample
+ * - Time spent inside updateReading() (total and worst single call)
+ * - CPU cycles per sample inside updateReading() (AVR Timer1 / ESP32 cycle
+ *   counter), including the blocking I2C transfers
+ * - Wall time per reading
+ * - Heap consumed while a reading is in progress (AVR and ESP only)
+ *
+ * A second table times only the per-sample accumulate/convert work, the
+ * v1.1.0 float path against the current integer path, over raw codes
+ * captured from a real reading (see SampleKernels.h).
+ *
+ * Output is CSV so results can be compared between library versions.
+ * Send any character to re-run the sweep.
+ */
+
+#include "APAPHX_ADS1015.h"
+#include "SampleKernels.h"
+
+#if defined(ESP32) || defined(ESP8266)
+#include <Esp.h>
+#endif
+
+ADS1015 ads1015(ADDRESS_49);
+
+const int SAMPLES[] = {10, 100};
+const int DELAYS_MS[] = {0, 10};
+const uint8_t AVG_BUFFERS[] = {1, 3, 10};
+const uint16_t GAINS[] = {
+    ADS1015_REG_SET_GAIN0_6_144V,
+    ADS1015_REG_SET_GAIN1_4_096V,
+    ADS1015_REG_SET_GAIN2_2_048V,
+    ADS1015_REG_SET_GAIN4_1_024V,
+    ADS1015_REG_SET_GAIN8_0_512V,
+    ADS1015_REG_SET_GAIN16_0_256V
+};
+
+#define COUNT_OF(a) (sizeof(a) / sizeof((a)[0]))
+
+const int KERNEL_CODES = 64;         // Raw codes captured for the kernel comparison
+const int KERNEL_REPETITIONS = 50;   // Passes over the codes per kernel
+int16_t kernelCodes[KERNEL_CODES];
+volatile float kernelSink;           // Keeps the kernels' results alive
+
+#if defined(__AVR__)
+extern char* __brkval;
+extern char __heap_start;
+#endif
+
+/**
+ * Cycle counter for single updateReading() calls.
+ * AVR: Timer1 runs at the CPU clock; calls longer than 65535 cycles saturate.
+ * ESP32: the CPU cycle counter. Other boards report 0.
+ */
+void cycleCounterBegin() {
+#if defined(__AVR__) && defined(TCCR1B)
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);  // No prescaler
+#endif
+}
+
+inline uint32_t cycleCounterNow() {
+#if defined(ESP32)
+    return ESP.getCycleCount();
+#elif defined(__AVR__) && defined(TCNT1)
+    TIFR1 = _BV(TOV1);
+    TCNT1 = 0;
+    return 0;
+#else
+    return 0;
+#endif
+}
+
+inline uint32_t cycleCounterSince(uint32_t start) {
+#if defined(ESP32)
+    return ESP.getCycleCount() - start;
+#elif defined(__AVR__) && defined(TCNT1)
+    uint16_t cycles = TCNT1;
+    return (TIFR1 & _BV(TOV1)) ? 0xFFFFUL : cycles;
+#else
+    (void)start;
+    return 0;
+#endif
+}
+
+/**
+ * Returns free heap in bytes, or 0 where the platform gives no cheap way to ask
+ */
+long freeHeap() {
+#if defined(ESP32) || defined(ESP8266)
+    return ESP.getFreeHeap();
+#elif defined(__AVR__)
+    char top;
+    return &top - (__brkval == 0 ? &__heap_start : __brkval);
+#else
+    return 0;
+#endif
+}
+
+void setup() {
+    Serial.begin(115200);
+    ads1015.begin();
+    cycleCounterBegin();
+
+    Serial.println(F("APAPHX Benchmark"));
+    runSweep();
+}
+
+void loop() {
+    if (Serial.available()) {
+        while (Serial.available()) Serial.read();
+        runSweep();
+    }
+}
+
+void runSweep() {
+    Serial.println(F("samples,delay_ms,gain,avg_buffer,transactions_per_sample,bytes_per_sample,"
+                     "update_us_total,update_us_max,update_calls,update_cycles_per_sample,wall_ms,heap_bytes"));
+
+    for (uint8_t s = 0; s < COUNT_OF(SAMPLES); s++) {
+        for (uint8_t d = 0; d < COUNT_OF(DELAYS_MS); d++) {
+            for (uint8_t g = 0; g < COUNT_OF(GAINS); g++) {
+                for (uint8_t a = 0; a < COUNT_OF(AVG_BUFFERS); a++) {
+                    PHXConfig config = {
+                        .type = "ph",
+                        .samples = SAMPLES[s],
+                        .delay_ms = DELAYS_MS[d],
+                        .avg_buffer = AVG_BUFFERS[a]
+                    };
+                    benchmarkReading(config, GAINS[g]);
+                }
+            }
+        }
+    }
+    compareKernels();
+    Serial.println(F("done"));
+}
+
+/**
+ * Times the per-sample statistics work alone, without I2C.
+ * micros() over many passes, so AVR's 4 us resolution does not matter.
+ */
+template <typename Kernel, typename Setup>
+float nanosPerSample(Kernel& kernel, Setup setup) {
+    unsigned long start = micros();
+    for (int r = 0; r < KERNEL_REPETITIONS; r++) {
+        kernel.reset(setup);
+        for (int i = 0; i < KERNEL_CODES; i++) {
+            kernel.add(kernelCodes[i]);
+        }
+        kernelSink = kernel.meanMilliVolts();
+    }
+    unsigned long elapsed = micros() - start;
+    return elapsed * 1000.0f / ((float)KERNEL_REPETITIONS * KERNEL_CODES);
+}
+
+void compareKernels() {
+    const uint16_t gain = ADS1015_REG_SET_GAIN0_6_144V;
+
+    // Capture real codes so both kernels see the sensor's values
+    ads1015.setGain(gain);
+    ads1015.setSampleBuffer(kernelCodes, KERNEL_CODES);
+    PHXConfig config = {
+        .type = "ph",
+        .samples = KERNEL_CODES,
+        .delay_ms = 0,
+        .avg_buffer = 1
+    };
+    ads1015.startReading(config);
+    while (ads1015.getState() != PHXState::IDLE) {
+        ads1015.updateReading();
+    }
+    ads1015.setSampleBuffer(nullptr, 0);
+
+    FloatKernel floatKernel;
+    IntegerKernel integerKernel;
+    float floatNs = nanosPerSample(floatKernel, gain);
+    float integerNs = nanosPerSample(integerKernel, 3.0f);  // mV per code at 6.144V
+
+    Serial.println(F("kernel,ns_per_sample,cycles_per_sample"));
+    printKernel(F("float_v1_1_0"), floatNs);
+    printKernel(F("integer"), integerNs);
+}
+
+void printKernel(const __FlashStringHelper* name, float ns) {
+    Serial.print(name); Serial.print(',');
+    Serial.print(ns, 1); Serial.print(',');
+#ifdef F_CPU
+    Serial.println(ns * (F_CPU / 1000000UL) / 1000.0f, 0);
+#else
+    Serial.println(0);
+#endif
+}
+
+/**
+ * Runs one reading and prints a CSV row with its cost
+ */
+void benchmarkReading(const PHXConfig& config, uint16_t gain) {
+    ads1015.setGain(gain);
+    ads1015.resetBusStats();
+
+    long heapBefore = freeHeap();
+    long heapLowest = heapBefore;
+    unsigned long updateTotal = 0;
+    unsigned long updateMax = 0;
+    unsigned long updateCalls = 0;
+    uint32_t cyclesTotal = 0;
+
+    unsigned long wallStart = millis();
+    ads1015.startReading(config);
+
+    while (ads1015.getState() != PHXState::IDLE) {
+        long heap = freeHeap();
+        if (heap < heapLowest) heapLowest = heap;
+
+        unsigned long t0 = micros();
+        uint32_t c0 = cycleCounterNow();
+        ads1015.updateReading();
+        cyclesTotal += cycleCounterSince(c0);
+        unsigned long elapsed = micros() - t0;
+
+        updateTotal += elapsed;
+        if (elapsed > updateMax) updateMax = elapsed;
+        updateCalls++;
+    }
+    unsigned long wall = millis() - wallStart;
+
+    const PHXBusStats& bus = ads1015.getBusStats();
+
+    Serial.print(config.samples); Serial.print(',');
+    Serial.print(config.delay_ms); Serial.print(',');
+    Serial.print(gain, HEX); Serial.print(',');
+    Serial.print(config.avg_buffer); Serial.print(',');
+    Serial.print((float)bus.transactions / config.samples, 2); Serial.print(',');
+    Serial.print((float)bus.bytes / config.samples, 2); Serial.print(',');
+    Serial.print(updateTotal); Serial.print(',');
+    Serial.print(updateMax); Serial.print(',');
+    Serial.print(updateCalls); Serial.print(',');
+    Serial.print(cyclesTotal / config.samples); Serial.print(',');
+    Serial.print(wall); Serial.print(',');
+    Serial.println(heapBefore - heapLowest);
+}
@@ -0,0 +1,94 @@
+/**
+ * APAPHX Callback Example
+ * Event-driven pH and ORP readings without waiting loops
+ *
+ * Each sensor reports finished readings through a callback, which also
+ * starts the next reading. loop() only advances the sensors and stays
+ * free for other work (display, networking, pump control).
+ */
+
+#include "APAPHX_ADS1015.h"
+
+// Create sensor instances
+ADS1015 ads1015PH(ADDRESS_49);  // pH sensor
+ADS1015 ads1015RX(ADDRESS_48);  // ORP sensor
+
+PHXConfig phConfig = {
+    .type = "ph",
+    .samples = 100,
+    .delay_ms = 10,
+    .avg_buffer = 3
+};
+
+PHXConfig rxConfig = {
+    .type = "rx",
+    .samples = 100,
+    .delay_ms = 10,
+    .avg_buffer = 3
+};
+
+const unsigned long READING_INTERVAL_MS = 1000;
+unsigned long nextPHReading = 0;
+unsigned long nextRXReading = 0;
+
+/**
+ * Called by updateReading() when a pH reading is complete
+ */
+void onPHReading(ADS1015& sensor, const PHXReadingResult& result) {
+    Serial.print(F("pH: "));
+    Serial.print(result.value, 2);
+    Serial.print(F(" (avg "));
+    Serial.print(sensor.getAverageReading(), 2);
+    Serial.print(F(", noise "));
+    Serial.print(result.stats.stddev_mV, 1);
+    Serial.print(F(" mV)"));
+    if (result.error != PHXError::NONE) {
+        Serial.print(F(" OUT OF RANGE"));
+    }
+    Serial.println();
+
+    nextPHReading = result.timestamp + READING_INTERVAL_MS;
+}
+
+/**
+ * Called by updateReading() when an ORP reading is complete
+ */
+void onRXReading(ADS1015& sensor, const PHXReadingResult& result) {
+    (void)sensor;
+    Serial.print(F("ORP: "));
+    Serial.print(result.value, 0);
+    Serial.println(F(" mV"));
+
+    nextRXReading = result.timestamp + READING_INTERVAL_MS;
+}
+
+void setup() {
+    Serial.begin(9600);
+
+    ads1015PH.begin();
+    ads1015RX.begin();
+
+    ads1015PH.setGain(ADS1015_REG_SET_GAIN1_4_096V);
+    ads1015RX.setGain(ADS1015_REG_SET_GAIN1_4_096V);
+
+    ads1015PH.setReadingCallback(onPHReading);
+    ads1015RX.setReadingCallback(onRXReading);
+
+    Serial.println(F("APAPHX Callback Test"));
+}
+
+void loop() {
+    // Start readings when they are due
+    if (ads1015PH.getState() == PHXState::IDLE && (long)(millis() - nextPHReading) >= 0) {
+        ads1015PH.startReading(phConfig);
+    }
+    if (ads1015RX.getState() == PHXState::IDLE && (long)(millis() - nextRXReading) >= 0) {
+        ads1015RX.startReading(rxConfig);
+    }
+
+    // Advance both sensors; results arrive in the callbacks
+    ads1015PH.updateReading();
+    ads1015RX.updateReading();
+
+    // ... other work here, as long as it returns quickly
+}
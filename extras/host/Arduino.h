@@ -0,0 +1,37 @@
+/**
+ * @file Arduino.h
+ * @brief Host stand-in for the Arduino core, for building the library on Linux
+ *
+ * Provides only what APAPHX_ADS1015 uses. Time comes from the simulated
+ * clock in SimADS1015.h, so tests and benchmarks are deterministic.
+ */
+
+#ifndef APAPHX_HOST_ARDUINO_H
+#define APAPHX_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <cmath>
+#include <cstdlib>
+
+using std::abs;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// Simulated clock (SimADS1015.cpp)
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+#endif // APAPHX_HOST_ARDUINO_H
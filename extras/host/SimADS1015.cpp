@@ -0,0 +1,331 @@
+/**
+ * @file SimADS1015.cpp
+ * @brief Simulated clock, TwoWire bus and ADS1015 register model
+ */
+
+#include "SimADS1015.h"
+#include "Arduino.h"
+
+TwoWire Wire;
+TwoWire Wire1;
+
+// ==================== Clock ====================
+
+namespace {
+    const uint8_t MAX_SIM_DEVICES = 8;
+
+    unsigned long g_now = 0;
+    unsigned long g_callCost = 1;
+    SimADS1015* g_devices[MAX_SIM_DEVICES] = {};
+
+    void registerDevice(SimADS1015* device) {
+        for (uint8_t i = 0; i < MAX_SIM_DEVICES; i++) {
+            if (g_devices[i] == nullptr) {
+                g_devices[i] = device;
+                return;
+            }
+        }
+    }
+
+    void unregisterDevice(SimADS1015* device) {
+        for (uint8_t i = 0; i < MAX_SIM_DEVICES; i++) {
+            if (g_devices[i] == device) g_devices[i] = nullptr;
+        }
+    }
+}
+
+namespace SimClock {
+    unsigned long now() { return g_now; }
+
+    void advance(unsigned long us) {
+        g_now += us;
+        for (uint8_t i = 0; i < MAX_SIM_DEVICES; i++) {
+            if (g_devices[i] != nullptr) g_devices[i]->update(g_now);
+        }
+    }
+
+    void setCallCost(unsigned long us) { g_callCost = us; }
+
+    void reset() { g_now = 0; }
+}
+
+unsigned long micros() {
+    SimClock::advance(g_callCost);
+    return g_now;
+}
+
+unsigned long millis() {
+    SimClock::advance(g_callCost);
+    return g_now / 1000;
+}
+
+void delay(unsigned long ms) { SimClock::advance(ms * 1000); }
+
+void delayMicroseconds(unsigned int us) { SimClock::advance(us); }
+
+// ==================== TwoWire ====================
+
+void TwoWire::beginTransmission(uint8_t address) {
+    _address = address;
+    _txLength = 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+    if (_txLength >= BUFFER_SIZE) return 0;
+    _tx[_txLength++] = data;
+    return 1;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+    (void)sendStop;
+    busTime(_txLength + 1);
+    SimADS1015* device = find(_address);
+    if (device == nullptr || injectFault()) return 2;  // Address NACK
+
+    device->busWrite(_tx, _txLength);
+    transactions++;
+    bytes += _txLength + 1;
+    return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity) {
+    if (quantity > BUFFER_SIZE) quantity = BUFFER_SIZE;
+    busTime(quantity + 1);
+    _rxIndex = 0;
+    _rxLength = 0;
+    SimADS1015* device = find(address);
+    if (device == nullptr || injectFault()) return 0;
+
+    _rxLength = device->busRead(_rx, quantity);
+    transactions++;
+    bytes += quantity + 1;
+    return _rxLength;
+}
+
+int TwoWire::read() {
+    if (_rxIndex >= _rxLength) return -1;
+    return _rx[_rxIndex++];
+}
+
+bool TwoWire::attach(SimADS1015* device) {
+    for (uint8_t i = 0; i < MAX_DEVICES; i++) {
+        if (_devices[i] == nullptr) {
+            _devices[i] = device;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TwoWire::detach(SimADS1015* device) {
+    for (uint8_t i = 0; i < MAX_DEVICES; i++) {
+        if (_devices[i] == device) _devices[i] = nullptr;
+    }
+}
+
+SimADS1015* TwoWire::find(uint8_t address) const {
+    for (uint8_t i = 0; i < MAX_DEVICES; i++) {
+        if (_devices[i] != nullptr && _devices[i]->address() == address) return _devices[i];
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Counts down failTransfer
+ * @return True if this transfer is the one to NACK
+ */
+bool TwoWire::injectFault() {
+    if (failTransfer < 0) return false;
+    return failTransfer-- == 0;
+}
+
+/**
+ * @brief Advances the clock by the time bytes take on the bus
+ *
+ * Nine clocks per byte (eight data bits plus ACK); start/stop
+ * conditions are ignored.
+ */
+void TwoWire::busTime(size_t byteCount) const {
+    SimClock::advance((byteCount * 9 * 1000000UL + _clockHz / 2) / _clockHz);
+}
+
+// ==================== ADS1015 model ====================
+
+namespace {
+    const uint16_t OS_BIT = 0x8000;
+    const uint16_t MODE_SINGLE = 0x0100;
+    const uint16_t CMODE_WINDOW = 0x0010;
+    const uint16_t CLAT = 0x0004;
+    const uint16_t CQUE_MASK = 0x0003;
+
+    const unsigned int SAMPLE_RATES[8] = {128, 250, 490, 920, 1600, 2400, 3300, 3300};
+    const float FULL_SCALE[8] = {6.144f, 4.096f, 2.048f, 1.024f, 0.512f, 0.256f, 0.256f, 0.256f};
+}
+
+SimADS1015::SimADS1015(uint8_t address, TwoWire& bus) : _bus(bus), _address(address), _rng(1) {
+    _bus.attach(this);
+    registerDevice(this);
+}
+
+SimADS1015::~SimADS1015() {
+    _bus.detach(this);
+    unregisterDevice(this);
+}
+
+void SimADS1015::setInput(uint8_t ain, float volts) {
+    if (ain < 4) _inputs[ain] = volts;
+}
+
+void SimADS1015::setNoise(float sigmaVolts) { _noise = sigmaVolts; }
+
+void SimADS1015::setDrift(float voltsPerSecond) { _drift = voltsPerSecond; }
+
+void SimADS1015::setMains(float amplitudeVolts, float hz) {
+    _mainsAmplitude = amplitudeVolts;
+    _mainsHz = hz;
+}
+
+void SimADS1015::setOscillatorError(float fraction) { _oscillatorError = fraction; }
+
+void SimADS1015::setSeed(uint32_t seed) { _rng.seed(seed); }
+
+void SimADS1015::setAlertHandler(SimAlertHandler handler, void* context) {
+    _alertHandler = handler;
+    _alertContext = context;
+}
+
+float SimADS1015::inputVolts(uint16_t config, unsigned long us) const {
+    float t = us * 1e-6f;
+    float common = _drift * t;
+    if (_mainsAmplitude != 0) {
+        common += _mainsAmplitude * sinf(2.0f * (float)M_PI * _mainsHz * t);
+    }
+
+    // Common-mode terms cancel on differential inputs
+    switch ((config >> 12) & 0x07) {
+        case 0: return _inputs[0] - _inputs[1];
+        case 1: return _inputs[0] - _inputs[3];
+        case 2: return _inputs[1] - _inputs[3];
+        case 3: return _inputs[2] - _inputs[3];
+        default: return _inputs[(config >> 12) & 0x03] + common;
+    }
+}
+
+void SimADS1015::busWrite(const uint8_t* data, uint8_t length) {
+    if (length == 0) return;
+    _pointer = data[0] & 0x03;
+    if (length < 3) return;  // Pointer-only write
+
+    update(SimClock::now());
+    uint16_t value = ((uint16_t)data[1] << 8) | data[2];
+    switch (_pointer) {
+        case 1: {
+            bool wasContinuous = continuous();
+            _config = value & ~OS_BIT;
+            _faults = 0;
+            if ((_config & CQUE_MASK) == CQUE_MASK) _alertActive = false;
+
+            if (continuous()) {
+                startConversion(SimClock::now());  // Config change restarts the conversion
+            } else if (value & OS_BIT) {
+                if (!_converting || wasContinuous) startConversion(SimClock::now());
+            } else if (wasContinuous) {
+                _converting = false;  // Power down
+            }
+            break;
+        }
+        case 2: _lowThresh = value; break;
+        case 3: _highThresh = value; break;
+        default: break;  // Conversion register is read-only
+    }
+}
+
+uint8_t SimADS1015::busRead(uint8_t* data, uint8_t length) {
+    update(SimClock::now());
+    uint16_t value;
+    switch (_pointer) {
+        case 0:
+            value = _conversion;
+            if (_config & CLAT) _alertActive = false;  // Reading releases a latched ALERT
+            break;
+        case 1: value = _config | (_converting ? 0 : OS_BIT); break;
+        case 2: value = _lowThresh; break;
+        default: value = _highThresh; break;
+    }
+
+    uint8_t bytes[2] = {(uint8_t)(value >> 8), (uint8_t)(value & 0xFF)};
+    for (uint8_t i = 0; i < length; i++) {
+        data[i] = bytes[i & 1];
+    }
+    return length;
+}
+
+void SimADS1015::update(unsigned long us) {
+    while (_converting && (long)(us - _conversionEnd) >= 0) {
+        finishConversion(_conversionEnd);
+    }
+}
+
+unsigned long SimADS1015::conversionTimeUs() const {
+    float period = 1e6f / SAMPLE_RATES[(_config >> 5) & 0x07];
+    return (unsigned long)(period * (1.0f + _oscillatorError) + 0.5f);
+}
+
+void SimADS1015::startConversion(unsigned long us) {
+    _converting = true;
+    _conversionEnd = us + conversionTimeUs();
+}
+
+void SimADS1015::finishConversion(unsigned long us) {
+    float volts = inputVolts(_config, us);
+    if (_noise > 0) {
+        std::normal_distribution<float> gaussian(0.0f, _noise);
+        volts += gaussian(_rng);
+    }
+
+    long code = lroundf(volts / FULL_SCALE[(_config >> 9) & 0x07] * 2048.0f);
+    code = constrain(code, -2048L, 2047L);
+    _conversion = (uint16_t)(code * 16);
+    _conversions++;
+
+    if (continuous()) {
+        startConversion(us);
+    } else {
+        _converting = false;
+    }
+    comparator((int16_t)code);
+}
+
+void SimADS1015::comparator(int16_t code) {
+    uint16_t queue = _config & CQUE_MASK;
+    if (queue == CQUE_MASK) return;  // Comparator disabled
+
+    // Conversion-ready mode pulses once per conversion
+    if ((_highThresh & 0x8000) && !(_lowThresh & 0x8000)) {
+        _alertActive = false;
+        assertAlert();
+        if (continuous()) _alertActive = false;
+        return;
+    }
+
+    int16_t low = (int16_t)_lowThresh >> 4;
+    int16_t high = (int16_t)_highThresh >> 4;
+    bool fault = (_config & CMODE_WINDOW) ? (code > high || code < low) : code > high;
+    bool release = (_config & CMODE_WINDOW) ? !fault : code < low;
+
+    if (fault) {
+        uint8_t needed = (queue == 0) ? 1 : (queue == 1) ? 2 : 4;
+        if (_faults < needed) _faults++;
+        if (_faults >= needed) assertAlert();
+    } else {
+        _faults = 0;
+        if (release && !(_config & CLAT)) _alertActive = false;
+    }
+}
+
+void SimADS1015::assertAlert() {
+    if (_alertActive) return;
+    _alertActive = true;
+    _alertCount++;
+    if (_alertHandler != nullptr) _alertHandler(_alertContext);
+}
@@ -0,0 +1,111 @@
+/**
+ * @file SimADS1015.h
+ * @brief Simulated ADS1015 register model and clock for host builds
+ *
+ * Models what the library relies on:
+ * - Config, conversion, Lo_thresh and Hi_thresh registers and the pointer register
+ * - Single-shot (OS bit) and continuous conversions with the latency of the
+ *   selected data rate, optionally skewed by an oscillator error
+ * - PGA full-scale ranges and 12-bit left-justified results
+ * - Input voltages per AINx with programmable Gaussian noise, linear drift
+ *   and mains hum
+ * - Traditional/window comparator with fault queue and latching, and the
+ *   conversion-ready mode of the ALERT/RDY pin
+ *
+ * Time is simulated: micros()/millis() advance by a small step per call
+ * (standing in for CPU time, so polling loops make progress) and every bus
+ * transfer advances by its duration at the bus clock.
+ */
+
+#ifndef APAPHX_SIM_ADS1015_H
+#define APAPHX_SIM_ADS1015_H
+
+#include <stdint.h>
+#include <random>
+#include "Wire.h"
+
+namespace SimClock {
+    /// Current simulated time in microseconds
+    unsigned long now();
+    /// Moves the clock forward, running conversions that finish meanwhile
+    void advance(unsigned long us);
+    /// Time added by every micros()/millis() call (default 1 us)
+    void setCallCost(unsigned long us);
+    /// Restarts time at zero
+    void reset();
+}
+
+/// Called when the ALERT/RDY pin asserts
+typedef void (*SimAlertHandler)(void* context);
+
+class SimADS1015 {
+public:
+    explicit SimADS1015(uint8_t address = 0x48, TwoWire& bus = Wire);
+    ~SimADS1015();
+
+    // Analog front end
+    void setInput(uint8_t ain, float volts);       ///< AIN0..AIN3 in volts
+    void setNoise(float sigmaVolts);               ///< Gaussian noise per conversion
+    void setDrift(float voltsPerSecond);           ///< Added to every input, grows from time 0
+    void setMains(float amplitudeVolts, float hz); ///< Sine hum on every input
+    void setOscillatorError(float fraction);       ///< +0.05 = conversions take 5% longer
+    void setSeed(uint32_t seed);
+
+    // ALERT/RDY pin
+    void setAlertHandler(SimAlertHandler handler, void* context = nullptr);
+    bool alertActive() const { return _alertActive; }
+    unsigned long alertCount() const { return _alertCount; }  ///< Assertions so far
+
+    // Register inspection
+    uint16_t config() const { return _config; }
+    int16_t lowThreshold() const { return (int16_t)_lowThresh; }
+    int16_t highThreshold() const { return (int16_t)_highThresh; }
+    bool continuous() const { return (_config & 0x0100) == 0; }
+    unsigned long conversions() const { return _conversions; }
+
+    /// Input voltage the selected mux sees at time us (without noise)
+    float inputVolts(uint16_t config, unsigned long us) const;
+
+    // Bus side (used by TwoWire)
+    uint8_t address() const { return _address; }
+    void busWrite(const uint8_t* data, uint8_t length);
+    uint8_t busRead(uint8_t* data, uint8_t length);
+
+    /// Runs conversions finishing up to time us (called by SimClock)
+    void update(unsigned long us);
+
+private:
+    unsigned long conversionTimeUs() const;
+    void startConversion(unsigned long us);
+    void finishConversion(unsigned long us);
+    void comparator(int16_t code);
+    void assertAlert();
+
+    TwoWire& _bus;
+    uint8_t _address;
+    uint8_t _pointer = 0;
+    uint16_t _config = 0x8583;      ///< Power-on default
+    uint16_t _conversion = 0;
+    uint16_t _lowThresh = 0x8000;
+    uint16_t _highThresh = 0x7FF0;
+
+    bool _converting = false;
+    unsigned long _conversionEnd = 0;
+    unsigned long _conversions = 0;
+
+    float _inputs[4] = {0, 0, 0, 0};
+    float _noise = 0;
+    float _drift = 0;
+    float _mainsAmplitude = 0;
+    float _mainsHz = 50;
+    float _oscillatorError = 0;
+    std::mt19937 _rng;
+
+    uint8_t _faults = 0;
+    bool _alertActive = false;
+    unsigned long _alertCount = 0;
+    SimAlertHandler _alertHandler = nullptr;
+    void* _alertContext = nullptr;
+};
+
+#endif // APAPHX_SIM_ADS1015_H
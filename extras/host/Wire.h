@@ -0,0 +1,64 @@
+/**
+ * @file Wire.h
+ * @brief Host stand-in for the Arduino TwoWire class
+ *
+ * Routes transfers to simulated devices attached to the bus and advances
+ * the simulated clock by the time the transfer takes on the wire.
+ */
+
+#ifndef APAPHX_HOST_WIRE_H
+#define APAPHX_HOST_WIRE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+class SimADS1015;
+
+class TwoWire {
+public:
+    static const uint8_t MAX_DEVICES = 4;
+    static const uint8_t BUFFER_SIZE = 32;
+
+    void begin() {}
+    void setClock(uint32_t clockHz) { _clockHz = clockHz; }
+    uint32_t getClock() const { return _clockHz; }
+
+    void beginTransmission(uint8_t address);
+    size_t write(uint8_t data);
+    uint8_t endTransmission(bool sendStop = true);
+    uint8_t requestFrom(uint8_t address, uint8_t quantity);
+    int available() const { return _rxLength - _rxIndex; }
+    int read();
+
+    /**
+     * @brief Attach a simulated device (done by the SimADS1015 constructor)
+     * @return False if the bus is full
+     */
+    bool attach(SimADS1015* device);
+    void detach(SimADS1015* device);
+
+    // Independent traffic counters, for checking the library's own PHXBusStats
+    unsigned long transactions = 0;  ///< Completed write or read transfers
+    unsigned long bytes = 0;         ///< Bytes on the wire including address bytes
+    /// Fault injection: transfers to let through before one is NACKed (-1 = none)
+    int failTransfer = -1;
+
+private:
+    SimADS1015* find(uint8_t address) const;
+    bool injectFault();
+    void busTime(size_t byteCount) const;
+
+    SimADS1015* _devices[MAX_DEVICES] = {};
+    uint32_t _clockHz = 100000;
+    uint8_t _address = 0;
+    uint8_t _tx[BUFFER_SIZE];
+    uint8_t _txLength = 0;
+    uint8_t _rx[BUFFER_SIZE];
+    uint8_t _rxLength = 0;
+    uint8_t _rxIndex = 0;
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#endif // APAPHX_HOST_WIRE_H
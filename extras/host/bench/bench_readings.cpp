@@ -0,0 +1,93 @@
+/**
+ * @file bench_readings.cpp
+ * @brief Host counterpart of examples/benchmark-example against the simulated bus
+ *
+ * Runs the same PHXConfig sweep as the sketch and prints one CSV row per
+ * configuration. Bus traffic and simulated wall time match what the
+ * target sees at the given I2C clock; update_ns is host CPU time spent
+ * inside updateReading(), useful for comparing library versions on the
+ * same machine rather than as an absolute figure.
+ *
+ * Usage: bench_readings [i2c_clock_hz]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include "APAPHX_ADS1015.h"
+#include "SimADS1015.h"
+
+static const int SAMPLES[] = {10, 100};
+static const int DELAYS_MS[] = {0, 10};
+static const uint8_t AVG_BUFFERS[] = {1, 3, 10};
+static const uint16_t GAINS[] = {
+    ADS1015_REG_SET_GAIN0_6_144V,
+    ADS1015_REG_SET_GAIN1_4_096V,
+    ADS1015_REG_SET_GAIN2_2_048V,
+    ADS1015_REG_SET_GAIN4_1_024V,
+    ADS1015_REG_SET_GAIN8_0_512V,
+    ADS1015_REG_SET_GAIN16_0_256V
+};
+
+#define COUNT_OF(a) (sizeof(a) / sizeof((a)[0]))
+
+static const unsigned long POLL_US = 10;  ///< Simulated loop() time between updateReading() calls
+
+static void benchmarkReading(ADS1015& adc, const PHXConfig& config, uint16_t gain) {
+    typedef std::chrono::steady_clock Clock;
+
+    adc.setGain(gain);
+    adc.resetBusStats();
+
+    long long updateTotal = 0;
+    long long updateMax = 0;
+    unsigned long updateCalls = 0;
+
+    unsigned long wallStart = SimClock::now();
+    adc.startReading(config);
+
+    while (adc.getState() != PHXState::IDLE) {
+        Clock::time_point t0 = Clock::now();
+        adc.updateReading();
+        long long elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+
+        updateTotal += elapsed;
+        if (elapsed > updateMax) updateMax = elapsed;
+        updateCalls++;
+        SimClock::advance(POLL_US);
+    }
+    unsigned long wall = SimClock::now() - wallStart;
+
+    const PHXBusStats& bus = adc.getBusStats();
+    printf("%d,%d,%X,%u,%.2f,%.2f,%lld,%lld,%lu,%.3f\n",
+           config.samples, config.delay_ms, gain, config.avg_buffer,
+           (float)bus.transactions / config.samples,
+           (float)bus.bytes / config.samples,
+           updateTotal, updateMax, updateCalls, wall / 1000.0);
+}
+
+int main(int argc, char** argv) {
+    uint32_t clockHz = argc > 1 ? (uint32_t)strtoul(argv[1], nullptr, 10) : 100000;
+
+    SimADS1015 sim;
+    sim.setInput(0, 0.1f);
+    sim.setNoise(0.001f);
+
+    ADS1015 adc(ADDRESS_48);
+    adc.begin(clockHz);
+
+    printf("samples,delay_ms,gain,avg_buffer,transactions_per_sample,bytes_per_sample,"
+           "update_ns_total,update_ns_max,update_calls,wall_ms\n");
+
+    for (size_t s = 0; s < COUNT_OF(SAMPLES); s++) {
+        for (size_t d = 0; d < COUNT_OF(DELAYS_MS); d++) {
+            for (size_t g = 0; g < COUNT_OF(GAINS); g++) {
+                for (size_t a = 0; a < COUNT_OF(AVG_BUFFERS); a++) {
+                    PHXConfig config = {"ph", SAMPLES[s], DELAYS_MS[d], AVG_BUFFERS[a]};
+                    benchmarkReading(adc, config, GAINS[g]);
+                }
+            }
+        }
+    }
+    return 0;
+}
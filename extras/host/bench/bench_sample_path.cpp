@@ -0,0 +1,98 @@
+/**
+ * @file bench_sample_path.cpp
+ * @brief Per-sample cost of the v1.1.0 float path against the integer path
+ *
+ * Captures the raw codes of a real reading from the simulated ADC, checks
+ * that both kernels reproduce the library's statistics for them, then
+ * times each kernel over the same codes. No bus or simulator time is
+ * included, only the accumulate/convert work done for every sample.
+ *
+ * On a host with an FPU both are a few nanoseconds per sample; the
+ * float path's per-sample divide matters on FPU-less targets, which the
+ * benchmark sketch measures with the same kernels.
+ *
+ * Usage: bench_sample_path [repetitions]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include "APAPHX_ADS1015.h"
+#include "SimADS1015.h"
+#include "SampleKernels.h"
+
+static const int CODES = 512;
+
+static int16_t g_codes[CODES];
+static volatile float g_sink;  ///< Keeps the kernels' results alive
+
+template <typename Kernel, typename Setup>
+static double nanosPerSample(Kernel& kernel, Setup setup, long repetitions) {
+    typedef std::chrono::steady_clock Clock;
+
+    Clock::time_point start = Clock::now();
+    for (long r = 0; r < repetitions; r++) {
+        kernel.reset(setup);
+        for (int i = 0; i < CODES; i++) {
+            kernel.add(g_codes[i]);
+        }
+        g_sink = kernel.meanMilliVolts();
+    }
+    double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return elapsed / ((double)repetitions * CODES);
+}
+
+int main(int argc, char** argv) {
+    long repetitions = argc > 1 ? strtol(argv[1], nullptr, 10) : 20000;
+    if (repetitions < 1) repetitions = 1;
+
+    const uint16_t gain = ADS1015_REG_SET_GAIN1_4_096V;
+    const float mVPerCode = 2.0f;
+
+    // Capture one reading's raw codes through the library
+    SimADS1015 sim;
+    sim.setInput(0, 1.25f);
+    sim.setNoise(0.01f);
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(gain);
+    adc.setSampleBuffer(g_codes, CODES);
+
+    PHXConfig config = {"mv", CODES, 0, 1};
+    adc.startReading(config);
+    while (adc.getState() != PHXState::IDLE) {
+        adc.updateReading();
+        SimClock::advance(10);
+    }
+    const PHXStats& stats = adc.getLastStats();
+
+    FloatKernel floatKernel;
+    IntegerKernel integerKernel;
+    floatKernel.reset(gain);
+    integerKernel.reset(mVPerCode);
+    for (int i = 0; i < CODES; i++) {
+        floatKernel.add(g_codes[i]);
+        integerKernel.add(g_codes[i]);
+    }
+
+    // Both kernels must describe the reading the library took
+    bool agree = fabsf(integerKernel.meanMilliVolts() - stats.mean_mV) < 1e-3f &&
+                 fabsf(integerKernel.stddevMilliVolts() - stats.stddev_mV) < 1e-3f &&
+                 fabsf(floatKernel.meanMilliVolts() - stats.mean_mV) < 1e-2f &&
+                 fabsf(floatKernel.stddevMilliVolts() - stats.stddev_mV) < 1e-2f;
+    if (!agree) {
+        printf("kernels disagree with the library: mean %f/%f/%f stddev %f/%f/%f\n",
+               stats.mean_mV, floatKernel.meanMilliVolts(), integerKernel.meanMilliVolts(),
+               stats.stddev_mV, floatKernel.stddevMilliVolts(), integerKernel.stddevMilliVolts());
+        return 1;
+    }
+
+    double floatNs = nanosPerSample(floatKernel, gain, repetitions);
+    double integerNs = nanosPerSample(integerKernel, mVPerCode, repetitions);
+
+    printf("kernel,ns_per_sample\n");
+    printf("float_v1_1_0,%.3f\n", floatNs);
+    printf("integer,%.3f\n", integerNs);
+    printf("speedup,%.2f\n", floatNs / integerNs);
+    return 0;
+}
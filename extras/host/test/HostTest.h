@@ -0,0 +1,59 @@
+/**
+ * @file HostTest.h
+ * @brief Minimal checks and helpers shared by the host tests
+ */
+
+#ifndef APAPHX_HOST_TEST_H
+#define APAPHX_HOST_TEST_H
+
+#include <stdio.h>
+#include <math.h>
+#include "APAPHX_ADS1015.h"
+#include "SimADS1015.h"
+
+static int g_failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            g_failures++; \
+        } \
+    } while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance) \
+    do { \
+        double _a = (actual), _e = (expected); \
+        if (!(fabs(_a - _e) <= (tolerance))) { \
+            printf("%s:%d: %s = %g, expected %g +/- %g\n", __FILE__, __LINE__, \
+                   #actual, _a, _e, (double)(tolerance)); \
+            g_failures++; \
+        } \
+    } while (0)
+
+/// Exit status of a test program
+#define TEST_RESULT() (g_failures == 0 ? 0 : 1)
+
+/**
+ * @brief Runs updateReading() until the ADC is idle
+ * @param pollUs Simulated time between calls
+ * @param timeoutMs Simulated time after which the reading counts as stuck
+ * @return False if the reading did not finish in time
+ */
+static inline bool runReading(ADS1015& adc, unsigned long pollUs = 10, unsigned long timeoutMs = 60000) {
+    unsigned long start = SimClock::now();
+    while (adc.getState() != PHXState::IDLE) {
+        adc.updateReading();
+        SimClock::advance(pollUs);
+        if (SimClock::now() - start > timeoutMs * 1000UL) return false;
+    }
+    return true;
+}
+
+/// Starts a reading and runs it to completion
+static inline bool takeReading(ADS1015& adc, const PHXConfig& config, unsigned long pollUs = 10) {
+    adc.startReading(config);
+    return runReading(adc, pollUs);
+}
+
+#endif // APAPHX_HOST_TEST_H
@@ -0,0 +1,201 @@
+/**
+ * @file test_alarms.cpp
+ * @brief Window-comparator alarms on the simulated ALERT/RDY pin
+ */
+
+#include "HostTest.h"
+
+static int g_alerts = 0;
+
+// Stands in for the sketch's FALLING-edge interrupt
+static void onAlertPin(void* context) {
+    static_cast<ADS1015*>(context)->notifyAlert();
+}
+
+static void onAlarm(ADS1015& sensor) {
+    (void)sensor;
+    g_alerts++;
+}
+
+/// Lets the comparator run for a while, servicing updateReading()
+static void watch(ADS1015& adc, unsigned long ms) {
+    unsigned long start = SimClock::now();
+    while (SimClock::now() - start < ms * 1000UL) {
+        adc.updateReading();
+        SimClock::advance(100);
+    }
+}
+
+// An alarm fires outside the window, latches until cleared and is
+// re-armed after a reading on another input
+static void alarmFiresAndLatches() {
+    SimADS1015 sim;
+    sim.setInput(0, 0.7f);
+    sim.setInput(1, 1.5f);
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN1_4_096V);
+    sim.setAlertHandler(onAlertPin, &adc);
+    adc.setAlertCallback(onAlarm);
+    g_alerts = 0;
+
+    PHXAlarmConfig alarm = {"mv", 500.0f, 1000.0f, PHXInput::AIN0, 2, true};
+    CHECK(adc.enableAlarm(alarm));
+    CHECK(adc.isAlarmEnabled());
+    watch(adc, 50);
+    CHECK(sim.alertCount() == 0);
+
+    sim.setInput(0, 1.1f);
+    watch(adc, 50);
+    CHECK(sim.alertCount() == 1);
+    CHECK(g_alerts == 1);
+    CHECK(adc.isAlarmTriggered());
+
+    // Latched: stays asserted back inside the window until cleared
+    sim.setInput(0, 0.7f);
+    watch(adc, 50);
+    CHECK(sim.alertActive());
+    adc.clearAlarm();
+    CHECK(!sim.alertActive());
+    CHECK(!adc.isAlarmTriggered());
+
+    // A reading on another input pauses the comparator and re-arms it
+    PHXConfig config = {"mv", 10, 0, 1, PHXInput::AIN1};
+    CHECK(takeReading(adc, config));
+    CHECK_NEAR(adc.getLastReading(), 1500.0, 4.0);
+    watch(adc, 50);
+    CHECK(sim.alertCount() == 1);
+
+    sim.setInput(0, 0.4f);
+    watch(adc, 50);
+    CHECK(sim.alertCount() == 2);
+    CHECK(g_alerts == 2);
+
+    adc.disableAlarm();
+    CHECK(!sim.continuous());
+}
+
+// Limits convert through the pH calibration; the comparator picks a range
+// that holds them whatever the reading gain
+static void alarmLimitsOutsideReadingRange() {
+    SimADS1015 sim;
+    sim.setInput(0, 0.7f);
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN4_1_024V);
+    sim.setAlertHandler(onAlertPin, &adc);
+
+    PHX_Calibration cal = {500.0f, 1000.0f, 4.0f, 7.0f};
+    adc.calibratePHX("ph", cal);
+
+    // pH 7.8 is 1133 mV, beyond the +/-1.024 V reading range
+    PHXAlarmConfig alarm = {"ph", 5.0f, 7.8f, PHXInput::AIN0, 1, false};
+    CHECK(adc.enableAlarm(alarm));
+    CHECK(sim.highThreshold() / 16 < 2047);
+    watch(adc, 50);
+    CHECK(sim.alertCount() == 0);
+
+    sim.setInput(0, 3.0f);
+    watch(adc, 50);
+    CHECK(sim.alertCount() == 1);
+
+    // Not latching: released back inside the window
+    sim.setInput(0, 0.8f);
+    watch(adc, 50);
+    CHECK(!sim.alertActive());
+}
+
+// Auto-ranging tightens the reading gain after every reading; the alarm
+// keeps its own range and still fires
+static void alarmSurvivesAutoRange() {
+    SimADS1015 sim;
+    sim.setInput(0, 0.7f);
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.enableAutoRange(true);
+    sim.setAlertHandler(onAlertPin, &adc);
+
+    PHX_Calibration cal = {500.0f, 1000.0f, 4.0f, 7.0f};
+    adc.calibratePHX("ph", cal);
+    PHXAlarmConfig alarm = {"ph", 5.0f, 7.8f, PHXInput::AIN0, 1, false};
+    CHECK(adc.enableAlarm(alarm));
+
+    PHXConfig config = {"ph", 20, 0, 1, PHXInput::AIN0};
+    for (int i = 0; i < 3; i++) {
+        CHECK(takeReading(adc, config));
+        CHECK_NEAR(adc.getLastReading(), 5.2, 0.02);
+    }
+    CHECK(adc.getGain() == ADS1015_REG_SET_GAIN4_1_024V);
+    CHECK(adc.isAlarmEnabled());
+
+    sim.setInput(0, 3.0f);
+    watch(adc, 50);
+    CHECK(sim.alertCount() == 1);
+}
+
+// Direct conversions and mode switches must not leave an enabled alarm
+// unable to fire
+static void directConversionsKeepAlarm() {
+    SimADS1015 sim;
+    sim.setInput(0, 0.7f);
+    sim.setInput(1, 1.5f);
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN1_4_096V);
+    sim.setAlertHandler(onAlertPin, &adc);
+
+    PHXAlarmConfig alarm = {"mv", 500.0f, 1000.0f, PHXInput::AIN0, 1, false};
+    CHECK(adc.enableAlarm(alarm));
+    uint16_t armed = sim.config();
+    int16_t low = sim.lowThreshold();
+    int16_t high = sim.highThreshold();
+
+    CHECK_NEAR(adc.readADC(PHXInput::AIN1), 750, 1);
+    CHECK(sim.config() == armed);
+
+    adc.startADC_SingleEnded(1);
+    while (!adc.conversionComplete()) {
+        SimClock::advance(10);
+    }
+    CHECK_NEAR(adc.getLastConversionResult(), 750, 1);
+    CHECK(sim.config() == armed);
+
+    adc.startContinuous(PHXInput::AIN1);
+    adc.stopContinuous();
+    adc.enableContinuousMode(false);
+    adc.enableConversionReady(false);
+    CHECK(sim.config() == armed);
+    CHECK(sim.lowThreshold() == low);
+    CHECK(sim.highThreshold() == high);
+
+    sim.setInput(0, 1.1f);
+    watch(adc, 50);
+    CHECK(sim.alertCount() == 1);
+}
+
+// A limit no range can hold is refused rather than clamped
+static void unreachableLimitRefused() {
+    SimADS1015 sim;
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+
+    PHXAlarmConfig alarm = {"mv", 100.0f, 7000.0f, PHXInput::AIN0, 1, false};
+    CHECK(!adc.enableAlarm(alarm));
+    CHECK(!adc.isAlarmEnabled());
+    CHECK(!sim.continuous());
+
+    PHXAlarmConfig below = {"mv", -6500.0f, 100.0f, PHXInput::DIFF_0_1, 1, false};
+    CHECK(!adc.enableAlarm(below));
+
+    PHXAlarmConfig widest = {"mv", -5000.0f, 5000.0f, PHXInput::DIFF_0_1, 1, false};
+    CHECK(adc.enableAlarm(widest));
+}
+
+int main() {
+    alarmFiresAndLatches();
+    alarmLimitsOutsideReadingRange();
+    alarmSurvivesAutoRange();
+    directConversionsKeepAlarm();
+    unreachableLimitRefused();
+    return TEST_RESULT();
+}
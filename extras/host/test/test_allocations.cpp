@@ -0,0 +1,84 @@
+/**
+ * @file test_allocations.cpp
+ * @brief Readings must not allocate: counts every operator new call
+ */
+
+#include <new>
+#include <stdlib.h>
+#include "HostTest.h"
+
+static unsigned long g_allocations = 0;
+
+void* operator new(size_t size) {
+    g_allocations++;
+    void* p = malloc(size ? size : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    g_allocations++;
+    void* p = malloc(size ? size : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+static ADS1015Fixed<64> adc(ADDRESS_48);
+
+static void sampleCallback(ADS1015&, uint8_t, float, float) {}
+static void readingCallback(ADS1015&, const PHXReadingResult&) {}
+
+int main() {
+    // The counter itself works
+    unsigned long start = g_allocations;
+    int* volatile probe = new int(1);  // volatile: the allocation may not be elided
+    delete probe;
+    CHECK(g_allocations == start + 1);
+
+    SimADS1015 sim;
+    sim.setInput(0, 1.1f);
+    sim.setInput(1, 0.6f);
+    sim.setNoise(0.002f);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN1_4_096V);
+    adc.setSampleCallback(sampleCallback);
+    adc.setReadingCallback(readingCallback);
+    adc.enableTemperatureCompensation(true);
+    adc.setTemperature(28.0f);
+
+    const PHXAggregation aggregations[] = {
+        PHXAggregation::MEAN, PHXAggregation::MEDIAN, PHXAggregation::TRIMMED_MEAN,
+        PHXAggregation::WINSORIZED_MEAN, PHXAggregation::HAMPEL
+    };
+    const PHXChannelConfig channels[] = {
+        {PHXInput::AIN0, "ph", ADS1015_REG_SET_GAIN1_4_096V, nullptr},
+        {PHXInput::AIN1, "rx", ADS1015_REG_SET_GAIN2_2_048V, nullptr}
+    };
+
+    unsigned long before = g_allocations;
+    for (int round = 0; round < 20; round++) {
+        adc.enableContinuousMode(round % 2 == 1);
+        for (size_t a = 0; a < sizeof(aggregations) / sizeof(aggregations[0]); a++) {
+            PHXConfig config = {"ph", 64, 0, 5, PHXInput::AIN0, 0, aggregations[a]};
+            CHECK(takeReading(adc, config));
+        }
+        PHXConfig filtered = {"ph", 64, 0, 5, PHXInput::AIN0, 0, PHXAggregation::MEAN,
+                              PHXFilter::LOWPASS, 50.0f};
+        CHECK(takeReading(adc, filtered));
+
+        adc.startScan(channels, 2, 16, 0);
+        CHECK(runReading(adc));
+    }
+    CHECK(adc.getLastStats().validSamples > 0);
+
+    if (g_allocations != before) {
+        printf("%lu allocations during readings\n", g_allocations - before);
+    }
+    CHECK(g_allocations == before);
+    return TEST_RESULT();
+}
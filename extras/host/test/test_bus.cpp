@@ -0,0 +1,91 @@
+/**
+ * @file test_bus.cpp
+ * @brief PHXBus: several ADS1015 sensors converting in parallel on one bus
+ */
+
+#include "HostTest.h"
+
+/// Runs bus.update() until every sensor is idle; returns the time taken in us
+static unsigned long runBus(PHXBus& bus) {
+    unsigned long start = SimClock::now();
+    while (!bus.isIdle() && SimClock::now() - start < 10000000UL) {
+        bus.update();
+        SimClock::advance(10);
+    }
+    return SimClock::now() - start;
+}
+
+// Four sensors take about as long as one, and each reads its own chip
+static void readingsRunInParallel() {
+    const uint8_t addresses[] = {ADDRESS_48, ADDRESS_49, ADDRESS_4A, ADDRESS_4B};
+    SimADS1015* sims[4];
+    ADS1015* sensors[4];
+    PHXBus bus(Wire1);
+    for (uint8_t i = 0; i < 4; i++) {
+        sims[i] = new SimADS1015(addresses[i], Wire1);
+        sims[i]->setInput(0, 0.4f * (i + 1));
+        sensors[i] = new ADS1015(addresses[i]);
+        sensors[i]->setGain(ADS1015_REG_SET_GAIN1_4_096V);
+        CHECK(bus.addDevice(*sensors[i]));
+    }
+    ADS1015 extra(ADDRESS_48);
+    CHECK(!bus.addDevice(extra));
+    CHECK(bus.getDeviceCount() == 4);
+    bus.begin(400000);
+    CHECK(Wire1.getClock() == 400000);
+
+    // One sensor alone, as the reference time
+    PHXConfig config = {"mv", 50, 0, 1};
+    unsigned long start = SimClock::now();
+    CHECK(takeReading(*sensors[0], config));
+    unsigned long single = SimClock::now() - start;
+
+    Wire.transactions = 0;
+    bus.startReadings(config);
+    CHECK(!bus.isIdle());
+    unsigned long parallel = runBus(bus);
+    CHECK(bus.isIdle());
+    CHECK(parallel < single * 3 / 2);
+    CHECK(Wire.transactions == 0);
+
+    for (uint8_t i = 0; i < 4; i++) {
+        CHECK_NEAR(bus.getDevice(i).getLastReading(), 400.0 * (i + 1), 2.0);
+        CHECK(bus.getDevice(i).getLastStats().validSamples == 50);
+        CHECK(sims[i]->conversions() >= 50);
+    }
+
+    for (uint8_t i = 0; i < 4; i++) {
+        delete sensors[i];
+        delete sims[i];
+    }
+}
+
+// Paced readings keep their interval on every sensor
+static void pacedReadingsShareTheSchedule() {
+    SimADS1015 simA(ADDRESS_48);
+    SimADS1015 simB(ADDRESS_49);
+    simA.setInput(1, 1.0f);
+    simB.setInput(1, 2.0f);
+    ADS1015 a(ADDRESS_48);
+    ADS1015 b(ADDRESS_49);
+    a.setGain(ADS1015_REG_SET_GAIN1_4_096V);
+    b.setGain(ADS1015_REG_SET_GAIN1_4_096V);
+    PHXBus bus;
+    CHECK(bus.addDevice(a));
+    CHECK(bus.addDevice(b));
+    bus.begin();
+
+    PHXConfig config = {"mv", 20, 5, 1, PHXInput::AIN1};
+    bus.startReadings(config);
+    unsigned long elapsed = runBus(bus);
+    CHECK(elapsed >= 19UL * 5000UL);
+    CHECK(elapsed < 21UL * 5000UL);
+    CHECK_NEAR(a.getLastReading(), 1000.0, 2.0);
+    CHECK_NEAR(b.getLastReading(), 2000.0, 2.0);
+}
+
+int main() {
+    readingsRunInParallel();
+    pacedReadingsShareTheSchedule();
+    return TEST_RESULT();
+}
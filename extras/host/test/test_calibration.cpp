@@ -0,0 +1,172 @@
+/**
+ * @file test_calibration.cpp
+ * @brief Calibration readings and multi-point calibration
+ */
+
+#include "HostTest.h"
+
+// A probe settling towards 600 mV with a 1 s time constant is followed
+// until consecutive readings agree
+static void calibrationSettles() {
+    SimADS1015 sim;
+    sim.setNoise(0.0005f);
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN2_2_048V);
+
+    unsigned long start = SimClock::now();
+    adc.startCalibration("ph", PHXInput::AIN0, 0);
+    CHECK(adc.isCalibrating());
+    while (adc.getState() != PHXState::IDLE) {
+        float t = (SimClock::now() - start) * 1e-6f;
+        sim.setInput(0, 0.6f + 0.05f * expf(-t));
+        adc.updateReading();
+        SimClock::advance(100);
+    }
+
+    CHECK(!adc.isCalibrating());
+    CHECK(adc.getLastError() == PHXError::NONE);
+    // Consecutive readings agree within STABILITY_THRESHOLD once the
+    // probe moves less than that per reading, a few mV from its end value
+    CHECK_NEAR(adc.getCalibrationReading(), 600.0, 3.0);
+    PHXCalibrationProgress progress = adc.getCalibrationProgress();
+    CHECK(progress.readings >= 3);
+    CHECK(fabsf(progress.drift_mV) < ADS1015::STABILITY_THRESHOLD * 2);
+    CHECK(progress.percent == 100);
+
+    // The blocking wrapper settles at once on a steady probe
+    sim.setInput(0, 0.45f);
+    CHECK_NEAR(adc.calibratePHXReading("ph"), 450.0, 1.0);
+    CHECK(adc.getLastError() == PHXError::NONE);
+    CHECK(adc.getCalibrationProgress().readings == 2);
+}
+
+// A probe that keeps drifting gives up at the timeout with the latest value
+static void calibrationTimesOut() {
+    SimADS1015 sim;
+    sim.setInput(0, 0.3f);
+    sim.setDrift(0.01f);  // 10 mV/s, never settles
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN2_2_048V);
+
+    SimClock::reset();
+    adc.startCalibration("rx", PHXInput::AIN0, 4000);
+    CHECK(runReading(adc, 100));
+    CHECK(adc.getLastError() == PHXError::CAL_TIMEOUT);
+    CHECK(!adc.isCalibrating());
+
+    PHXCalibrationProgress progress = adc.getCalibrationProgress();
+    CHECK(progress.elapsed_ms >= 4000);
+    CHECK(progress.elapsed_ms < 6000);
+    CHECK(progress.readings >= 2);
+    CHECK(fabsf(progress.drift_mV) > ADS1015::STABILITY_THRESHOLD);
+
+    // Best value so far: the mean of the last two readings
+    float expected = 300.0f + 10.0f * SimClock::now() * 1e-6f;
+    CHECK_NEAR(adc.getCalibrationReading(), expected, 20.0);
+}
+
+// cancelReading() aborts a calibration, and the sensor reads normally after
+static void calibrationCancelled() {
+    SimADS1015 sim;
+    sim.setInput(0, 0.5f);
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN2_2_048V);
+
+    adc.startCalibration("ph", PHXInput::AIN0, 0);
+    unsigned long start = SimClock::now();
+    while (SimClock::now() - start < 200000UL) {
+        adc.updateReading();
+        SimClock::advance(100);
+    }
+    CHECK(adc.isCalibrating());
+    CHECK(adc.getState() != PHXState::IDLE);
+
+    adc.cancelReading();
+    CHECK(!adc.isCalibrating());
+    CHECK(adc.getState() == PHXState::IDLE);
+    CHECK(adc.getLastError() == PHXError::NONE);
+
+    PHXConfig config = {"mv", 10, 0, 1};
+    CHECK(takeReading(adc, config));
+    CHECK_NEAR(adc.getLastReading(), 500.0, 1.5);
+}
+
+static float readAt(SimADS1015& sim, ADS1015& adc, float volts) {
+    sim.setInput(0, volts);
+    PHXConfig config = {"ph", 10, 0, 1};
+    takeReading(adc, config);
+    return adc.getLastReading();
+}
+
+// Piecewise points given out of order follow every standard and
+// extrapolate the end segments, at any gain
+static void piecewiseCalibration() {
+    SimADS1015 sim;
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN2_2_048V);
+
+    const PHXCalibrationPoint points[] = {{500.0f, 7.0f}, {300.0f, 10.0f}, {800.0f, 4.0f}};
+    CHECK(adc.calibratePHXPoints("ph", points, 3));
+    CHECK_NEAR(readAt(sim, adc, 0.8f), 4.0, 0.01);
+    CHECK_NEAR(readAt(sim, adc, 0.65f), 5.5, 0.01);
+    CHECK_NEAR(readAt(sim, adc, 0.5f), 7.0, 0.01);
+    CHECK_NEAR(readAt(sim, adc, 0.4f), 8.5, 0.01);
+    CHECK_NEAR(readAt(sim, adc, 0.2f), 11.5, 0.02);
+
+    adc.setGain(ADS1015_REG_SET_GAIN1_4_096V);
+    CHECK_NEAR(readAt(sim, adc, 0.4f), 8.5, 0.02);
+    CHECK_NEAR(readAt(sim, adc, 0.65f), 5.5, 0.02);
+}
+
+// Least squares fits one line through unsorted standards
+static void leastSquaresCalibration() {
+    SimADS1015 sim;
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN2_2_048V);
+
+    const PHXCalibrationPoint points[] = {{800.0f, 4.0f}, {300.0f, 10.0f}, {500.0f, 7.2f}};
+    CHECK(adc.calibratePHXPoints("ph", points, 3, PHXCalibrationFit::LEAST_SQUARES));
+
+    double meanMV = (800.0 + 300.0 + 500.0) / 3, meanValue = (4.0 + 10.0 + 7.2) / 3;
+    double sxy = 0, sxx = 0;
+    for (int i = 0; i < 3; i++) {
+        sxy += (points[i].mV - meanMV) * (points[i].value - meanValue);
+        sxx += (points[i].mV - meanMV) * (points[i].mV - meanMV);
+    }
+    double slope = sxy / sxx;
+    for (float volts = 0.25f; volts < 0.9f; volts += 0.15f) {
+        double expected = meanValue + slope * (volts * 1000.0 - meanMV);
+        CHECK_NEAR(readAt(sim, adc, volts), expected, 0.01);
+    }
+}
+
+// Points that cannot form a calibration leave the type reporting mV
+static void invalidCalibration() {
+    SimADS1015 sim;
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN2_2_048V);
+
+    const PHXCalibrationPoint same[] = {{500.0f, 7.0f}, {800.0f, 4.0f}, {500.0f, 6.0f}};
+    CHECK(!adc.calibratePHXPoints("ph", same, 3));
+    CHECK_NEAR(readAt(sim, adc, 0.6f), 600.0, 1.0);
+
+    const PHXCalibrationPoint one[] = {{500.0f, 7.0f}};
+    CHECK(!adc.calibratePHXPoints("ph", one, 1));
+    CHECK(!adc.calibratePHXPoints("xx", same, 2));
+}
+
+int main() {
+    calibrationSettles();
+    calibrationTimesOut();
+    calibrationCancelled();
+    piecewiseCalibration();
+    leastSquaresCalibration();
+    invalidCalibration();
+    return TEST_RESULT();
+}
@@ -0,0 +1,104 @@
+/**
+ * @file test_filters.cpp
+ * @brief Per-sample filters: mains notch tuning and unbiased statistics
+ */
+
+#include "HostTest.h"
+
+static PHXConfig filtered(int samples, int delay_ms, PHXFilter filter, float tolerance_mV = 0, float hz = 0) {
+    PHXConfig config = {"mv", samples, delay_ms, 1, PHXInput::AIN0, tolerance_mV,
+                        PHXAggregation::MEAN, filter, hz};
+    return config;
+}
+
+// The null lands on the mains frequency at any paced rate, including the
+// rates where 50 and 60 Hz alias to different frequencies
+static void notchRejectsMains() {
+    const int delays[] = {3, 5, 7, 10, 13};
+    for (int mains = 50; mains <= 60; mains += 10) {
+        for (size_t d = 0; d < sizeof(delays) / sizeof(delays[0]); d++) {
+            SimADS1015 sim;
+            sim.setInput(0, 1.0f);
+            sim.setMains(0.0495f, (float)mains);  // 35 mV rms
+            sim.setNoise(0.0005f);
+            ADS1015 adc(ADDRESS_48);
+            adc.begin();
+            adc.setGain(ADS1015_REG_SET_GAIN2_2_048V);
+
+            PHXFilter notch = (mains == 50) ? PHXFilter::NOTCH_50HZ : PHXFilter::NOTCH_60HZ;
+            CHECK(takeReading(adc, filtered(200, delays[d], PHXFilter::NONE)));
+            CHECK(adc.getLastStats().stddev_mV > 30.0f);
+
+            CHECK(takeReading(adc, filtered(200, delays[d], notch)));
+            CHECK(adc.getLastError() == PHXError::NONE);
+            CHECK(adc.getLastStats().stddev_mV < 1.5f);
+            CHECK_NEAR(adc.getLastReading(), 1000.0, 1.0);
+        }
+    }
+}
+
+// Rates the notch cannot be tuned to are reported, and the reading is
+// taken unfiltered
+static void notchRateErrors() {
+    SimADS1015 sim;
+    sim.setInput(0, 1.0f);
+    sim.setMains(0.0495f, 50.0f);
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN2_2_048V);
+
+    // Back to back: the rate follows the ADC oscillator and bus
+    CHECK(takeReading(adc, filtered(100, 0, PHXFilter::NOTCH_50HZ)));
+    CHECK(adc.getLastError() == PHXError::FILTER_RATE);
+    CHECK(adc.getLastStats().stddev_mV > 30.0f);
+    CHECK(adc.getLastStats().validSamples == 100);
+
+    // 50 SPS: 50 Hz aliases to DC
+    CHECK(takeReading(adc, filtered(20, 20, PHXFilter::NOTCH_50HZ)));
+    CHECK(adc.getLastError() == PHXError::FILTER_RATE);
+
+    // The error clears with a usable rate
+    CHECK(takeReading(adc, filtered(100, 10, PHXFilter::NOTCH_50HZ)));
+    CHECK(adc.getLastError() == PHXError::NONE);
+}
+
+// Filtered samples are correlated; the stop rule must still hold its
+// confidence and the mean must not pick up the start-up transient
+static void filtersKeepToleranceRule() {
+    const PHXFilter filters[] = {PHXFilter::NONE, PHXFilter::EMA, PHXFilter::LOWPASS};
+    for (size_t f = 0; f < sizeof(filters) / sizeof(filters[0]); f++) {
+        SimADS1015 sim;
+        sim.setInput(0, 0.8f);
+        sim.setNoise(0.004f);
+        ADS1015 adc(ADDRESS_48);
+        adc.begin();
+        adc.setGain(ADS1015_REG_SET_GAIN1_4_096V);
+
+        const int readings = 200;
+        int misses = 0;
+        double bias = 0;
+        for (int i = 0; i < readings; i++) {
+            sim.setSeed(100 + i);
+            CHECK(takeReading(adc, filtered(5000, 0, filters[f], 0.5f, 50.0f)));
+            double error = adc.getLastReading() - 800.0;
+            bias += error;
+            if (fabs(error) > 0.5) misses++;
+        }
+        CHECK(misses <= readings / 10);  // 95% confidence, with margin
+        CHECK_NEAR(bias / readings, 0.0, 0.15);
+
+        // The reported spread is that of the filtered samples
+        if (filters[f] == PHXFilter::NONE) {
+            CHECK_NEAR(adc.getLastStats().stddev_mV, 4.0, 0.8);
+        } else {
+            CHECK(adc.getLastStats().stddev_mV < 3.0f);
+        }
+    }
+}
+
+int main() {
+    notchRejectsMains();
+    notchRateErrors();
+    filtersKeepToleranceRule();
+    return TEST_RESULT();
+}
@@ -0,0 +1,115 @@
+/**
+ * @file test_modes.cpp
+ * @brief Switching between continuous and single-shot conversions
+ */
+
+#include "HostTest.h"
+
+// Streaming switched off during a reading must not feed the next one
+static void streamingOffMidReading() {
+    SimADS1015 sim;
+    sim.setInput(0, 0.3f);
+    sim.setInput(1, 1.2f);
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN1_4_096V);
+    adc.enableContinuousMode(true);
+
+    PHXConfig stream = {"mv", 20, 0, 1, PHXInput::AIN0};
+    adc.startReading(stream);
+    for (int i = 0; i < 50; i++) {
+        adc.updateReading();
+        SimClock::advance(10);
+    }
+    adc.enableContinuousMode(false);
+    CHECK(runReading(adc));
+    CHECK_NEAR(adc.getLastReading(), 300.0, 2.0);
+
+    PHXConfig single = {"mv", 20, 0, 1, PHXInput::AIN1};
+    CHECK(takeReading(adc, single));
+    CHECK_NEAR(adc.getLastReading(), 1200.0, 2.0);
+    CHECK(!sim.continuous());
+}
+
+// Scans convert single-shot even right after a continuous reading
+static void scanAfterContinuousReading() {
+    SimADS1015 sim;
+    sim.setInput(0, 0.5f);
+    sim.setInput(1, 1.0f);
+    sim.setInput(2, 1.5f);
+    sim.setInput(3, 2.0f);
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN0_6_144V);
+    adc.enableContinuousMode(true);
+
+    PHXConfig stream = {"mv", 10, 0, 1, PHXInput::AIN2};
+    CHECK(takeReading(adc, stream));
+    CHECK_NEAR(adc.getLastReading(), 1500.0, 3.0);
+
+    const PHXChannelConfig channels[] = {
+        {PHXInput::AIN0, "mv", ADS1015_REG_SET_GAIN0_6_144V, nullptr},
+        {PHXInput::AIN1, "mv", ADS1015_REG_SET_GAIN0_6_144V, nullptr},
+        {PHXInput::AIN2, "mv", ADS1015_REG_SET_GAIN0_6_144V, nullptr},
+        {PHXInput::AIN3, "mv", ADS1015_REG_SET_GAIN0_6_144V, nullptr}
+    };
+    adc.startScan(channels, 4, 5, 0);
+    CHECK(runReading(adc));
+    for (uint8_t i = 0; i < 4; i++) {
+        CHECK_NEAR(adc.getScanReading(i), 500.0 * (i + 1), 3.0);
+    }
+    CHECK(!sim.continuous());
+}
+
+// Each channel applies its own calibration; one whose references share a
+// millivolt value reports millivolts
+static void scanChannelCalibrations() {
+    SimADS1015 sim;
+    sim.setInput(0, 0.5f);
+    sim.setInput(1, 0.5f);
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+
+    const PHX_Calibration line = {400.0f, 700.0f, 4.0f, 10.0f};
+    const PHX_Calibration flat = {500.0f, 500.0f, 4.0f, 10.0f};
+    const PHXChannelConfig channels[] = {
+        {PHXInput::AIN0, "ph", ADS1015_REG_SET_GAIN2_2_048V, &line},
+        {PHXInput::AIN1, "ph", ADS1015_REG_SET_GAIN2_2_048V, &flat}
+    };
+    adc.startScan(channels, 2, 5, 0);
+    CHECK(runReading(adc));
+    CHECK_NEAR(adc.getScanReading(0), 6.0, 0.01);
+    CHECK_NEAR(adc.getScanReading(1), 500.0, 1.0);
+}
+
+// A NACKed transfer while streaming must not leave the register pointer
+// cache out of step with the device
+static void streamingRecoversFromBusFault() {
+    SimADS1015 sim;
+    sim.setInput(0, 1.2f);
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN1_4_096V);
+    adc.enableContinuousMode(true);
+
+    PHXConfig config = {"mv", 20, 0, 1};
+    for (int fault = 0; fault < 6; fault++) {
+        adc.enableContinuousMode(false);
+        adc.enableContinuousMode(true);
+        Wire.failTransfer = fault;
+        CHECK(takeReading(adc, config));
+        CHECK(Wire.failTransfer == -1);
+
+        CHECK(takeReading(adc, config));
+        CHECK_NEAR(adc.getLastReading(), 1200.0, 2.0);
+        CHECK(adc.getLastStats().min_mV > 1190.0f);
+    }
+}
+
+int main() {
+    streamingOffMidReading();
+    scanAfterContinuousReading();
+    scanChannelCalibrations();
+    streamingRecoversFromBusFault();
+    return TEST_RESULT();
+}
@@ -0,0 +1,217 @@
+/**
+ * @file test_readings.cpp
+ * @brief State machine, bus and conversion timing against the simulated ADC
+ */
+
+#include "HostTest.h"
+
+static void singleShotReading() {
+    SimADS1015 sim;
+    sim.setInput(0, 1.2f);
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN1_4_096V);
+
+    PHXConfig config = {"mv", 20, 0, 1};
+    CHECK(takeReading(adc, config));
+    CHECK(adc.isReadingComplete());
+    CHECK_NEAR(adc.getLastReading(), 1200.0, 2.0);
+    CHECK(adc.getLastStats().validSamples == 20);
+    CHECK(sim.conversions() == 20);
+    CHECK(!sim.continuous());
+}
+
+static void continuousReading() {
+    SimADS1015 sim;
+    sim.setInput(1, 0.8f);
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN1_4_096V);
+    adc.enableContinuousMode(true);
+
+    PHXConfig config = {"mv", 20, 0, 1, PHXInput::AIN1};
+    CHECK(takeReading(adc, config));
+    CHECK_NEAR(adc.getLastReading(), 800.0, 2.0);
+    CHECK(sim.continuous());
+
+    adc.enableContinuousMode(false);
+    CHECK(!sim.continuous());
+}
+
+static void busStatsMatchWire() {
+    SimADS1015 sim;
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    Wire.transactions = 0;
+    Wire.bytes = 0;
+
+    PHXConfig config = {"mv", 10, 0, 1};
+    CHECK(takeReading(adc, config));
+    CHECK(adc.getBusStats().transactions == Wire.transactions);
+    CHECK(adc.getBusStats().bytes == Wire.bytes);
+}
+
+static void conversionTimeFollowsDataRate() {
+    SimADS1015 sim;
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setDataRate(ADS1015_REG_CONFIG_DR_128SPS);
+
+    // 50 back-to-back conversions at 128 SPS take at least 50 periods
+    PHXConfig config = {"mv", 50, 0, 1};
+    unsigned long start = SimClock::now();
+    CHECK(takeReading(adc, config));
+    unsigned long elapsed = SimClock::now() - start;
+    CHECK(elapsed >= 50UL * 1000000UL / 128);
+    CHECK(elapsed <= 50UL * adc.getConversionTimeUs() + 50000UL);
+}
+
+static void differentialInput() {
+    SimADS1015 sim;
+    sim.setInput(0, 1.5f);
+    sim.setInput(1, 1.0f);
+    sim.setMains(0.2f, 50.0f);  // Common mode, cancels
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN2_2_048V);
+
+    PHXConfig config = {"mv", 10, 0, 1, PHXInput::DIFF_0_1};
+    CHECK(takeReading(adc, config));
+    CHECK_NEAR(adc.getLastReading(), 500.0, 1.0);
+}
+
+static void noiseAndDrift() {
+    SimADS1015 sim;
+    sim.setInput(0, 1.0f);
+    sim.setNoise(0.004f);
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN1_4_096V);
+
+    PHXConfig config = {"mv", 200, 0, 1};
+    CHECK(takeReading(adc, config));
+    CHECK_NEAR(adc.getLastReading(), 1000.0, 1.5);
+    CHECK_NEAR(adc.getLastStats().stddev_mV, 4.0, 0.8);
+
+    // 100 mV/s over a 1 s reading shows up as drift
+    sim.setNoise(0);
+    sim.setDrift(0.1f);
+    PHXConfig slow = {"mv", 11, 100, 1};
+    CHECK(takeReading(adc, slow));
+    CHECK_NEAR(adc.getLastStats().drift_mV, 100.0, 6.0);
+}
+
+// The first reading probes from the widest range and tightens; a clipped
+// sample widens the range and restarts the reading
+static void autoRangeProbesAndWidens() {
+    SimADS1015 sim;
+    sim.setInput(0, 0.3f);
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.enableAutoRange(true);
+
+    PHXConfig config = {"mv", 20, 0, 1};
+    CHECK(takeReading(adc, config));
+    CHECK(adc.getGain() == ADS1015_REG_SET_GAIN8_0_512V);
+    CHECK_NEAR(adc.getLastReading(), 300.0, 0.5);
+    CHECK(adc.getLastStats().validSamples == 20);
+
+    // 0.9 V clips at 0.512 V and fits 1.024 V
+    sim.setInput(0, 0.9f);
+    CHECK(takeReading(adc, config));
+    CHECK(adc.getGain() == ADS1015_REG_SET_GAIN4_1_024V);
+    CHECK_NEAR(adc.getLastReading(), 900.0, 1.0);
+    CHECK(adc.getLastStats().validSamples == 20);
+
+    // Only tightens between readings once the peak fits the tighter range
+    sim.setInput(0, 0.45f);
+    CHECK(takeReading(adc, config));
+    CHECK(adc.getGain() == ADS1015_REG_SET_GAIN4_1_024V);
+    sim.setInput(0, 0.35f);
+    CHECK(takeReading(adc, config));
+    CHECK(adc.getGain() == ADS1015_REG_SET_GAIN8_0_512V);
+
+    // Another input is probed afresh
+    sim.setInput(1, 2.5f);
+    PHXConfig other = {"mv", 20, 0, 1, PHXInput::AIN1};
+    CHECK(takeReading(adc, other));
+    CHECK(adc.getGain() == ADS1015_REG_SET_GAIN1_4_096V);
+    CHECK_NEAR(adc.getLastReading(), 2500.0, 2.0);
+}
+
+// The rolling average fills, wraps and restarts when the type or size
+// changes; the type may come from a buffer that is reused afterwards
+static void rollingAverage() {
+    SimADS1015 sim;
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN1_4_096V);
+
+    char type[8];
+    strcpy(type, "mv");
+    PHXConfig config = {type, 10, 0, 3};
+    const float inputs[] = {0.1f, 0.2f, 0.3f, 0.4f, 0.5f};
+    for (int i = 0; i < 5; i++) {
+        sim.setInput(0, inputs[i]);
+        CHECK(takeReading(adc, config));
+        CHECK(adc.isRollingAverageReady() == (i >= 2));
+        strcpy(type, "xx");  // The caller's buffer changes between readings
+        strcpy(type, "mv");
+    }
+    CHECK_NEAR(adc.getAverageReading(), 400.0, 1.0);
+
+    // Another string with the same type keeps the average
+    char copy[8];
+    strcpy(copy, "mv");
+    strcpy(type, "ph");
+    config.type = copy;
+    sim.setInput(0, 0.6f);
+    CHECK(takeReading(adc, config));
+    CHECK(adc.isRollingAverageReady());
+    CHECK_NEAR(adc.getAverageReading(), 500.0, 1.0);
+
+    // A different type restarts it
+    PHX_Calibration cal = {0.0f, 1000.0f, 0.0f, 1000.0f};
+    adc.calibratePHX("rx", cal);
+    PHXConfig orp = {"rx", 10, 0, 3};
+    CHECK(takeReading(adc, orp));
+    CHECK(!adc.isRollingAverageReady());
+    CHECK_NEAR(adc.getAverageReading(), 600.0, 1.0);
+
+    // So does a different size
+    orp.avg_buffer = 2;
+    CHECK(takeReading(adc, orp));
+    CHECK(!adc.isRollingAverageReady());
+    CHECK(takeReading(adc, orp));
+    CHECK(adc.isRollingAverageReady());
+}
+
+// A fixed-storage sensor on the second bus never touches Wire
+static void fixedStorageOnSecondBus() {
+    SimADS1015 sim(ADDRESS_48, Wire1);
+    sim.setInput(0, 0.7f);
+    ADS1015Fixed<8> adc(ADDRESS_48, Wire1);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN1_4_096V);
+    Wire.transactions = 0;
+    Wire1.transactions = 0;
+
+    PHXConfig config = {"mv", 8, 0, 1, PHXInput::AIN0, 0, PHXAggregation::MEDIAN};
+    CHECK(takeReading(adc, config));
+    CHECK_NEAR(adc.getLastReading(), 700.0, 2.0);
+    CHECK(Wire.transactions == 0);
+    CHECK(Wire1.transactions == adc.getBusStats().transactions);
+}
+
+int main() {
+    singleShotReading();
+    continuousReading();
+    busStatsMatchWire();
+    conversionTimeFollowsDataRate();
+    differentialInput();
+    noiseAndDrift();
+    autoRangeProbesAndWidens();
+    rollingAverage();
+    fixedStorageOnSecondBus();
+    return TEST_RESULT();
+}
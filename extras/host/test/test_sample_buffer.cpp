@@ -0,0 +1,80 @@
+/**
+ * @file test_sample_buffer.cpp
+ * @brief Raw sample storage and robust aggregation
+ */
+
+#include "HostTest.h"
+
+// The buffer holds the first samples; MEAN readings are not limited by it
+static void meanIgnoresCapacity() {
+    SimADS1015 sim;
+    sim.setInput(0, 0.5f);
+    ADS1015Fixed<16> adc(ADDRESS_48);
+    adc.begin();
+
+    PHXConfig config = {"mv", 1000, 0, 1};
+    CHECK(takeReading(adc, config));
+    CHECK(adc.getLastStats().validSamples == 1000);
+    CHECK_NEAR(adc.getLastReading(), 500.0, 3.0);
+}
+
+// Robust aggregation needs every sample stored, so it is capped
+static void robustAggregationUsesCapacity() {
+    SimADS1015 sim;
+    sim.setInput(0, 0.5f);
+    ADS1015Fixed<16> adc(ADDRESS_48);
+    adc.begin();
+
+    PHXConfig config = {"mv", 1000, 0, 1, PHXInput::AIN0, 0, PHXAggregation::MEDIAN};
+    CHECK(takeReading(adc, config));
+    CHECK(adc.getLastStats().validSamples == 16);
+    CHECK_NEAR(adc.getLastReading(), 500.0, 3.0);
+}
+
+// Stored samples follow the signal and the buffer end is respected
+static void storesFirstSamples() {
+    SimADS1015 sim;
+    sim.setInput(0, 0.3f);
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN1_4_096V);
+
+    int16_t storage[9];
+    storage[8] = 0x7777;  // Guard after the declared capacity
+    adc.setSampleBuffer(storage, 8);
+
+    PHXConfig config = {"mv", 40, 0, 1};
+    CHECK(takeReading(adc, config));
+    CHECK(adc.getLastStats().validSamples == 40);
+    for (int i = 0; i < 8; i++) {
+        CHECK(storage[i] == 150);  // 300 mV at 2 mV per code
+    }
+    CHECK(storage[8] == 0x7777);
+}
+
+// A robust estimator rejects a spike the mean would follow
+static void hampelRejectsSpike() {
+    SimADS1015 sim;
+    sim.setInput(0, 0.4f);
+    ADS1015Fixed<32> adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN1_4_096V);
+
+    PHXConfig config = {"mv", 32, 0, 1, PHXInput::AIN0, 0, PHXAggregation::HAMPEL};
+    adc.startReading(config);
+    while (adc.getState() != PHXState::IDLE) {
+        sim.setInput(0, adc.getState() == PHXState::COLLECTING && SimClock::now() % 7 == 0 ? 2.0f : 0.4f);
+        adc.updateReading();
+        SimClock::advance(10);
+    }
+    CHECK_NEAR(adc.getLastReading(), 400.0, 2.0);
+    CHECK(adc.getLastStats().max_mV > 500.0f);
+}
+
+int main() {
+    meanIgnoresCapacity();
+    robustAggregationUsesCapacity();
+    storesFirstSamples();
+    hampelRejectsSpike();
+    return TEST_RESULT();
+}
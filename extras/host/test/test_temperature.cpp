@@ -0,0 +1,118 @@
+/**
+ * @file test_temperature.cpp
+ * @brief Table-driven pH temperature compensation and ORP correction
+ */
+
+#include "HostTest.h"
+
+/// Pasco 2001 compensation around an isopotential point
+static double pasco(double pH, double celsius, double isopotential = 7.0) {
+    return (pH - isopotential) * (273.15 + celsius) / 298.15 + isopotential;
+}
+
+static float readAt(SimADS1015& sim, ADS1015& adc, const char* type, float volts) {
+    sim.setInput(0, volts);
+    PHXConfig config = {type, 10, 0, 1};
+    takeReading(adc, config);
+    return adc.getLastReading();
+}
+
+// The default table reproduces the formula between its 5 degree entries
+static void defaultTableMatchesPasco() {
+    SimADS1015 sim;
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN2_2_048V);
+    PHX_Calibration cal = {400.0f, 700.0f, 4.0f, 10.0f};  // 650 mV is pH 9
+    adc.calibratePHX("ph", cal);
+    adc.enableTemperatureCompensation(true);
+
+    const float temperatures[] = {0.0f, 12.3f, 25.0f, 37.7f, 50.0f};
+    for (size_t i = 0; i < sizeof(temperatures) / sizeof(temperatures[0]); i++) {
+        adc.setTemperature(temperatures[i]);
+        CHECK_NEAR(readAt(sim, adc, "ph", 0.65f), pasco(9.0, temperatures[i]), 0.002);
+        CHECK_NEAR(readAt(sim, adc, "ph", 0.325f), pasco(2.5, temperatures[i]), 0.002);
+    }
+
+    // Disabled: the calibrated value passes unchanged
+    adc.enableTemperatureCompensation(false);
+    CHECK_NEAR(readAt(sim, adc, "ph", 0.65f), 9.0, 0.002);
+}
+
+// The isopotential point moves the pH that temperature leaves unchanged
+static void isopotentialPoint() {
+    SimADS1015 sim;
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN2_2_048V);
+    PHX_Calibration cal = {400.0f, 700.0f, 4.0f, 10.0f};
+    adc.calibratePHX("ph", cal);
+    adc.enableTemperatureCompensation(true);
+    adc.setIsopotentialPoint(6.5f);
+    CHECK_NEAR(adc.getIsopotentialPoint(), 6.5, 1e-6);
+
+    adc.setTemperature(40.0f);
+    CHECK_NEAR(readAt(sim, adc, "ph", 0.525f), 6.5, 0.002);
+    CHECK_NEAR(readAt(sim, adc, "ph", 0.65f), pasco(9.0, 40.0, 6.5), 0.002);
+    CHECK_NEAR(readAt(sim, adc, "ph", 0.45f), pasco(5.0, 40.0, 6.5), 0.002);
+
+    adc.setIsopotentialPoint(20.0f);
+    CHECK_NEAR(adc.getIsopotentialPoint(), 14.0, 1e-6);
+}
+
+// A probe's own table is interpolated between entries, also through a
+// multi-point calibration
+static void customTable() {
+    SimADS1015 sim;
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN2_2_048V);
+    const PHXCalibrationPoint points[] = {{700.0f, 10.0f}, {400.0f, 4.0f}, {550.0f, 7.0f}};
+    CHECK(adc.calibratePHXPoints("ph", points, 3));
+    adc.enableTemperatureCompensation(true);
+
+    float factors[ADS1015::TEMP_TABLE_SIZE];
+    for (uint8_t i = 0; i < ADS1015::TEMP_TABLE_SIZE; i++) {
+        float celsius = i * ADS1015::TEMP_TABLE_STEP;
+        factors[i] = 0.9f + 0.004f * celsius + 0.00004f * celsius * celsius;
+    }
+    adc.setTemperatureTable(factors);
+
+    // 17.5 degrees lies halfway between the 15 and 20 degree entries
+    adc.setTemperature(17.5f);
+    double factor = (factors[3] + factors[4]) / 2;
+    CHECK_NEAR(readAt(sim, adc, "ph", 0.65f), (9.0 - 7.0) * factor + 7.0, 0.002);
+    CHECK_NEAR(readAt(sim, adc, "ph", 0.475f), (5.5 - 7.0) * factor + 7.0, 0.002);
+
+    adc.setTemperature(50.0f);
+    CHECK_NEAR(readAt(sim, adc, "ph", 0.65f), (9.0 - 7.0) * factors[10] + 7.0, 0.002);
+
+    // nullptr restores Pasco
+    adc.setTemperatureTable(nullptr);
+    CHECK_NEAR(readAt(sim, adc, "ph", 0.65f), pasco(9.0, 50.0), 0.002);
+}
+
+// ORP is corrected only once a coefficient is set
+static void orpCoefficient() {
+    SimADS1015 sim;
+    ADS1015 adc(ADDRESS_48);
+    adc.begin();
+    adc.setGain(ADS1015_REG_SET_GAIN2_2_048V);
+    PHX_Calibration cal = {200.0f, 800.0f, 210.0f, 790.0f};
+    adc.calibratePHX("rx", cal);
+    adc.enableTemperatureCompensation(true);
+    adc.setTemperature(35.0f);
+
+    double orp = 210.0 + (500.0 - 200.0) * 580.0 / 600.0;
+    CHECK_NEAR(readAt(sim, adc, "rx", 0.5f), orp, 0.05);
+    adc.setORPTemperatureCoefficient(1.5f);
+    CHECK_NEAR(readAt(sim, adc, "rx", 0.5f), orp - 1.5 * 10.0, 0.05);
+}
+
+int main() {
+    defaultTableMatchesPasco();
+    isopotentialPoint();
+    customTable();
+    orpCoefficient();
+    return TEST_RESULT();
+}